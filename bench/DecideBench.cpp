@@ -0,0 +1,470 @@
+#include "decide.h"
+#include "engine.h"
+#include "kernels.h"
+#include "parallel_engine.h"
+#include "thread_pool.h"
+#include "typed_engine.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Gives the benchmarks access to the private steps of Decide.
+class DecideBench {
+public:
+  // Computes one LIC from scratch, without the derived data that earlier
+  // calls left in the cache.
+  static bool lic(Decide &decide, int LIC) {
+    decide.CACHE.reset(decide.NUMPOINTS, decide.COORDINATES);
+    switch (LIC) {
+    case 0:
+      return decide.Lic0();
+    case 1:
+      return decide.Lic1();
+    case 2:
+      return decide.Lic2();
+    case 3:
+      return decide.Lic3();
+    case 4:
+      return decide.Lic4();
+    case 5:
+      return decide.Lic5();
+    case 6:
+      return decide.Lic6();
+    case 7:
+      return decide.Lic7();
+    case 8:
+      return decide.Lic8();
+    case 9:
+      return decide.Lic9();
+    case 10:
+      return decide.Lic10();
+    case 11:
+      return decide.Lic11();
+    case 12:
+      return decide.Lic12();
+    case 13:
+      return decide.Lic13();
+    case 14:
+      return decide.Lic14();
+    }
+    return false;
+  }
+
+  static void setCMV(Decide &decide, const std::array<bool, 15> &CMV) {
+    decide.CMV = CMV;
+  }
+  static void calcPUM(Decide &decide) { decide.Calc_PUM(); }
+  static void calcFUV(Decide &decide) { decide.Calc_FUV(); }
+};
+
+// Radians between consecutive points of circleTrack().
+const double STEP = 0.001;
+// Hit position meaning that no window meets the LIC, so it scans them all.
+const int NO_HIT = -1;
+
+/*
+ * Tracks and parameters are chosen so that no LIC is met, except where a hit
+ * is placed:
+ *  - circleTrack() puts the points on a unit circle around (2, 2), STEP
+ *    radians apart. All points are in quadrant I, consecutive angles are close
+ *    to PI, and every distance, radius and area stays below the thresholds of
+ *    quietParameters() for gaps up to a few hundred points.
+ *  - x decreases along half of the circle, so LICs 5 and 11 use lineTrack(),
+ *    along which x only grows.
+ */
+static POINTS_SOA circleTrack(int NUMPOINTS) {
+  POINTS_SOA points;
+  points.x.resize(NUMPOINTS);
+  points.y.resize(NUMPOINTS);
+  for (int i = 0; i < NUMPOINTS; ++i) {
+    points.x[i] = 2 + std::cos(STEP * i);
+    points.y[i] = 2 + std::sin(STEP * i);
+  }
+  return points;
+}
+
+static POINTS_SOA lineTrack(int NUMPOINTS) {
+  POINTS_SOA points;
+  points.x.resize(NUMPOINTS);
+  points.y.resize(NUMPOINTS, 2);
+  for (int i = 0; i < NUMPOINTS; ++i) {
+    points.x[i] = STEP * i;
+  }
+  return points;
+}
+
+static PARAMETERS_T quietParameters(int gap) {
+  PARAMETERS_T parameters;
+  parameters.LENGTH1 = 10;
+  parameters.RADIUS1 = 10;
+  parameters.EPSILON = 1;
+  parameters.AREA1 = 2;
+  parameters.Q_PTS = gap + 1;
+  parameters.QUADS = 1;
+  parameters.DIST = 3;
+  parameters.N_PTS = gap + 2;
+  parameters.K_PTS = gap;
+  parameters.A_PTS = gap;
+  parameters.B_PTS = gap;
+  parameters.C_PTS = gap;
+  parameters.D_PTS = gap;
+  parameters.E_PTS = gap;
+  parameters.F_PTS = gap;
+  parameters.G_PTS = gap;
+  parameters.LENGTH2 = 10;
+  parameters.RADIUS2 = 10;
+  parameters.AREA2 = 10;
+  return parameters;
+}
+
+// Longest window of quietParameters(gap), in points.
+static int span(int gap) { return 2 * gap + 3; }
+
+/**
+ * @brief Changes one point so that LIC is met by the windows of span(gap)
+ * points that end at it. percent picks the window among all of them, NO_HIT
+ * leaves the track alone. The point is moved far out from the circle along
+ * its radius, which meets every LIC but 4, 5 and 11; those get a point in
+ * quadrant III or a point with a much smaller x.
+ */
+static void placeHit(POINTS_SOA &points, int LIC, int gap, int percent) {
+  if (percent == NO_HIT)
+    return;
+  const int windows = points.size() - span(gap);
+  int i = span(gap) - 1 + (int)((long long)windows * percent / 100);
+  // LIC 6 only measures the points inside its window.
+  if (LIC == 6)
+    i = std::min(i, points.size() - 2);
+  if (LIC == 4) {
+    points.x[i] = points.y[i] = -1e6;
+  } else if (LIC == 5 || LIC == 11) {
+    points.x[i] = -1e6;
+  } else {
+    points.x[i] = 2 + 1e6 * (points.x[i] - 2);
+    points.y[i] = 2 + 1e6 * (points.y[i] - 2);
+  }
+}
+
+static LCM_T allConnectors(CONNECTORS connector) {
+  LCM_T lcm;
+  for (auto &row : lcm) {
+    row.fill(connector);
+  }
+  return lcm;
+}
+
+// Arguments: NUMPOINTS, gap and hit position (percent, or NO_HIT). Tracks
+// get at least one point more than the longest window, so that LICs 12, 13
+// and 14 can meet their second condition away from the hit.
+static void addArguments(benchmark::internal::Benchmark *b,
+                         const std::vector<int> &gaps) {
+  for (int64_t numpoints : benchmark::CreateRange(5, 10000000, 10)) {
+    for (int gap : gaps) {
+      if (numpoints <= span(gap))
+        continue;
+      for (int hit : {0, 50, NO_HIT}) {
+        b->Args({numpoints, gap, hit});
+      }
+    }
+  }
+}
+
+// LICs 0, 1, 2, 3 and 5 only look at consecutive points, which gap 0 stands
+// for.
+static void consecutiveArguments(benchmark::internal::Benchmark *b) {
+  addArguments(b, {0});
+}
+
+static void gapArguments(benchmark::internal::Benchmark *b) {
+  addArguments(b, {1, 16, 256});
+}
+
+static void BM_Lic(benchmark::State &state, int LIC) {
+  const int NUMPOINTS = state.range(0);
+  const int gap = state.range(1);
+  POINTS_SOA points = LIC == 5 || LIC == 11 ? lineTrack(NUMPOINTS)
+                                            : circleTrack(NUMPOINTS);
+  placeHit(points, LIC, gap, state.range(2));
+  std::array<bool, 15> puv = {false};
+  Decide decide(NUMPOINTS, POINTS_VIEW(points), quietParameters(gap),
+                allConnectors(NOTUSED), puv);
+
+  bool met = false;
+  for (auto _ : state) {
+    met = DecideBench::lic(decide, LIC);
+    benchmark::DoNotOptimize(met);
+  }
+  if (met != (state.range(2) != NO_HIT))
+    state.SkipWithError("LIC result does not match the placed hit");
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK_CAPTURE(BM_Lic, Lic0, 0)->Apply(consecutiveArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic1, 1)->Apply(consecutiveArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic2, 2)->Apply(consecutiveArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic3, 3)->Apply(consecutiveArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic4, 4)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic5, 5)->Apply(consecutiveArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic6, 6)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic7, 7)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic8, 8)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic9, 9)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic10, 10)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic11, 11)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic12, 12)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic13, 13)->Apply(gapArguments);
+BENCHMARK_CAPTURE(BM_Lic, Lic14, 14)->Apply(gapArguments);
+
+// The kernels gapKernels() falls back to, which take the gaps at run time.
+static const GAP_KERNELS_T RUNTIME_KERNELS = {
+    firstPairAtLeast,  firstPairAtMost,   firstRadiusAbove,
+    firstRadiusWithin, firstAngleOutside, firstAreaAbove,
+    firstAreaBelow,    firstDecrease};
+
+/**
+ * @brief The scan of one of LICs 7 to 14 through the kernel gapKernels()
+ * selects, with the gaps compiled in, or through the one that takes them at
+ * run time, over every window of a track on which the LIC is not met.
+ * Arguments: NUMPOINTS and the gap parameters, which are common values.
+ */
+static void BM_GapKernel(benchmark::State &state, int LIC, bool COMPILED) {
+  const int NUMPOINTS = state.range(0);
+  const int gap = state.range(1);
+  const POINTS_SOA points =
+      LIC == 11 ? lineTrack(NUMPOINTS) : circleTrack(NUMPOINTS);
+  const POINTS_VIEW C(points);
+  CONFIG_T config;
+  config.PARAMETERS = quietParameters(gap);
+  const CompiledConfig compiled(config);
+  const GAP_KERNELS_T K =
+      COMPILED ? gapKernels(config.PARAMETERS) : RUNTIME_KERNELS;
+  const int n = NUMPOINTS;
+  const int g = gap + 1;
+
+  int first = 0;
+  for (auto _ : state) {
+    switch (LIC) {
+    case 7:
+      first = K.pair_at_least(C, n, g, compiled.length1_far);
+      break;
+    case 8:
+      first = K.radius_above(C, n, g, g, config.PARAMETERS.RADIUS1);
+      break;
+    case 9:
+      first = K.angle_outside(C, n, g, g, compiled.angle_bounds);
+      break;
+    case 10:
+      first = K.area_above(C, n, g, g, config.PARAMETERS.AREA1);
+      break;
+    case 11:
+      first = K.decrease(C, n, g);
+      break;
+    case 12:
+      // No two distinct points of the track are this close.
+      first = K.pair_at_most(C, n, g, 0);
+      break;
+    case 13:
+      first = K.radius_within(C, n, g, g, 0);
+      break;
+    case 14:
+      first = K.area_below(C, n, g, g, 0);
+      break;
+    }
+    benchmark::DoNotOptimize(first);
+  }
+  if (first != -1)
+    state.SkipWithError("the LIC is met on the track");
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+
+static void commonGapArguments(benchmark::internal::Benchmark *b) {
+  for (int64_t numpoints : {1000, 100000}) {
+    for (int gap : {1, 4}) {
+      b->Args({numpoints, gap});
+    }
+  }
+}
+
+#define GAP_KERNEL_BENCHMARKS(LIC)                                            \
+  BENCHMARK_CAPTURE(BM_GapKernel, Lic##LIC##_compiled, LIC, true)             \
+      ->Apply(commonGapArguments);                                            \
+  BENCHMARK_CAPTURE(BM_GapKernel, Lic##LIC##_runtime, LIC, false)             \
+      ->Apply(commonGapArguments)
+GAP_KERNEL_BENCHMARKS(7);
+GAP_KERNEL_BENCHMARKS(8);
+GAP_KERNEL_BENCHMARKS(9);
+GAP_KERNEL_BENCHMARKS(10);
+GAP_KERNEL_BENCHMARKS(11);
+GAP_KERNEL_BENCHMARKS(12);
+GAP_KERNEL_BENCHMARKS(13);
+GAP_KERNEL_BENCHMARKS(14);
+
+// Decide for the PUM and FUV benchmarks, which do not depend on the points.
+static std::vector<COORDINATE> FIVE_POINTS(5, COORDINATE{0, 0});
+
+static void BM_CalcPUM(benchmark::State &state) {
+  LCM_T lcm = allConnectors(ANDD);
+  for (int i = 0; i < 15; ++i) {
+    for (int j = 0; j < 15; ++j) {
+      lcm[i][j] = (i + j) % 3 == 0 ? NOTUSED : (i + j) % 3 == 1 ? ORR : ANDD;
+    }
+  }
+  std::array<bool, 15> puv = {false};
+  Decide decide(5, FIVE_POINTS, quietParameters(1), lcm, puv);
+  std::array<bool, 15> cmv;
+  for (int i = 0; i < 15; ++i) {
+    cmv[i] = i % 2 == 0;
+  }
+  DecideBench::setCMV(decide, cmv);
+
+  for (auto _ : state) {
+    DecideBench::calcPUM(decide);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CalcPUM);
+
+static void BM_CalcFUV(benchmark::State &state) {
+  std::array<bool, 15> puv;
+  for (int i = 0; i < 15; ++i) {
+    puv[i] = i % 3 != 0;
+  }
+  Decide decide(5, FIVE_POINTS, quietParameters(1), allConnectors(ANDD), puv);
+  std::array<bool, 15> cmv;
+  for (int i = 0; i < 15; ++i) {
+    cmv[i] = i % 2 == 0;
+  }
+  DecideBench::setCMV(decide, cmv);
+  DecideBench::calcPUM(decide);
+
+  for (auto _ : state) {
+    DecideBench::calcFUV(decide);
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_CalcFUV);
+
+// Stream buffer that drops everything, for the YES/NO printed by decide().
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+};
+
+// End-to-end decide(). The hit is the radial outlier, which meets every LIC
+// but 4, 5 and 11; LICs 5 and 11 are met early on the circle anyway.
+static void BM_Decide(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  const int gap = state.range(1);
+  POINTS_SOA points = circleTrack(NUMPOINTS);
+  placeHit(points, 0, gap, state.range(2));
+  std::array<bool, 15> puv;
+  puv.fill(true);
+  Decide decide(NUMPOINTS, POINTS_VIEW(points), quietParameters(gap),
+                allConnectors(ANDD), puv);
+
+  NullBuffer null;
+  std::streambuf *out = std::cout.rdbuf(&null);
+  for (auto _ : state) {
+    decide.decide();
+  }
+  std::cout.rdbuf(out);
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK(BM_Decide)->Apply(gapArguments);
+
+// Configuration in which only the even LICs are connected, ANDD with each
+// other, so that the odd ones cannot affect the launch decision.
+static CONFIG_T evenConfig(int gap) {
+  CONFIG_T config;
+  config.PARAMETERS = quietParameters(gap);
+  config.LCM = allConnectors(NOTUSED);
+  config.PUV.fill(false);
+  for (int i = 0; i < 15; i += 2) {
+    for (int j = 0; j < 15; j += 2) {
+      config.LCM[i][j] = ANDD;
+    }
+    config.PUV[i] = true;
+  }
+  return config;
+}
+
+// Every CMV entry, then the launch decision.
+static void BM_EngineEvaluate(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  POINTS_SOA points = circleTrack(NUMPOINTS);
+  placeHit(points, 0, state.range(1), state.range(2));
+  DecideEngine engine{CompiledConfig(evenConfig(state.range(1)))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        engine.evaluate(NUMPOINTS, POINTS_VIEW(points)).LAUNCH);
+  }
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK(BM_EngineEvaluate)->Apply(gapArguments);
+
+// BM_EngineEvaluate with coordinates of type T. The unit circle track has no
+// meaningful int32_t counterpart, so only the floating point types are timed.
+template <typename T>
+static void BM_TypedEngineEvaluate(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  POINTS_SOA points = circleTrack(NUMPOINTS);
+  placeHit(points, 0, state.range(1), state.range(2));
+  std::vector<T> x(points.x.begin(), points.x.end());
+  std::vector<T> y(points.y.begin(), points.y.end());
+  TypedEngine<T> engine{CompiledConfig(evenConfig(state.range(1)))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(engine.evaluate(x, y).LAUNCH);
+  }
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK_TEMPLATE(BM_TypedEngineEvaluate, double)->Apply(gapArguments);
+BENCHMARK_TEMPLATE(BM_TypedEngineEvaluate, float)->Apply(gapArguments);
+
+// Only the CMV entries the launch decision needs, until it is known.
+static void BM_EngineLaunch(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  POINTS_SOA points = circleTrack(NUMPOINTS);
+  placeHit(points, 0, state.range(1), state.range(2));
+  DecideEngine engine{CompiledConfig(evenConfig(state.range(1)))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(engine.launch(NUMPOINTS, POINTS_VIEW(points)));
+  }
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK(BM_EngineLaunch)->Apply(gapArguments);
+
+// Batches of 4096 short tracks of NUMPOINTS points each, on a pool of THREADS
+// workers, THREADS = 0 for a plain loop over the frames with one engine.
+static void BM_DecideBatch(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  const int THREADS = state.range(1);
+  const int FRAMES = 4096;
+  POINTS_SOA points = circleTrack(NUMPOINTS * FRAMES);
+  std::vector<FRAME_T> frames(FRAMES);
+  for (int f = 0; f < FRAMES; ++f) {
+    frames[f].NUMPOINTS = NUMPOINTS;
+    frames[f].POINTS = POINTS_VIEW(points).from(f * NUMPOINTS);
+  }
+  std::vector<DECISION_T> decisions(FRAMES);
+  const CompiledConfig config(evenConfig(1));
+
+  if (THREADS == 0) {
+    DecideEngine engine(config);
+    for (auto _ : state) {
+      for (int f = 0; f < FRAMES; ++f)
+        decisions[f] = engine.evaluate(NUMPOINTS, frames[f].POINTS);
+      benchmark::ClobberMemory();
+    }
+  } else {
+    ThreadPool pool(THREADS);
+    ParallelEngine engine(pool, config);
+    for (auto _ : state) {
+      engine.decideBatch(frames.data(), FRAMES, decisions.data());
+      benchmark::ClobberMemory();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * FRAMES);
+}
+BENCHMARK(BM_DecideBatch)
+    ->ArgsProduct({{16, 256}, {0, 1, 2, 4, 8, 16, 32, 64}})
+    ->UseRealTime();
@@ -0,0 +1,61 @@
+#include "decide.h"
+#include "kernels.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+// LIC 6 before it was restricted to its window: every point of the track is
+// measured against the line of every window. Kept to show how the two scale.
+// The last window is skipped, as the old code read one point past the end.
+static bool legacyLic6(const std::vector<COORDINATE> &COORDINATES,
+                       int NUMPOINTS, int N_PTS, double DIST) {
+  for (int i = 0; i < NUMPOINTS - N_PTS; ++i) {
+    COORDINATE p1 = COORDINATES[i];
+    COORDINATE p2 = COORDINATES[i + N_PTS];
+    for (int j = 0; j < NUMPOINTS; ++j) {
+      if (j == i || j == i + N_PTS - 1)
+        continue;
+      COORDINATE p3 = COORDINATES[j];
+      double distance = fabs((p2.x - p1.x) * (p3.y - p1.y) -
+                             (p3.x - p1.x) * (p2.y - p1.y)) /
+                        sqrt(pow(p2.y - p1.y, 2) + pow(p2.x - p1.x, 2));
+      if (distance > DIST + 0.000001)
+        return true;
+    }
+  }
+  return false;
+}
+
+// Points on a straight line, so that no window satisfies LIC 6 and every
+// window has to be checked.
+static std::vector<COORDINATE> straightTrack(int NUMPOINTS) {
+  std::vector<COORDINATE> points(NUMPOINTS);
+  for (int i = 0; i < NUMPOINTS; ++i) {
+    points[i] = {1.0 * i, 2.0 * i};
+  }
+  return points;
+}
+
+static void BM_Lic6Legacy(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  const int N_PTS = state.range(1);
+  std::vector<COORDINATE> points = straightTrack(NUMPOINTS);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(legacyLic6(points, NUMPOINTS, N_PTS, 1.0));
+  }
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK(BM_Lic6Legacy)
+    ->ArgsProduct({benchmark::CreateRange(64, 4096, 4), {3, 16, 64}});
+
+static void BM_Lic6Windowed(benchmark::State &state) {
+  const int NUMPOINTS = state.range(0);
+  const int N_PTS = state.range(1);
+  POINTS_SOA points(straightTrack(NUMPOINTS));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        anyWindowFarFromLine(POINTS_VIEW(points), NUMPOINTS, N_PTS, 1.0));
+  }
+  state.SetItemsProcessed(state.iterations() * NUMPOINTS);
+}
+BENCHMARK(BM_Lic6Windowed)
+    ->ArgsProduct({benchmark::CreateRange(64, 1 << 20, 4), {3, 16, 64}});
@@ -0,0 +1,364 @@
+#include "batch.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "unlock.h"
+
+// Bound on the error of the angles, in radians. The dot and cross products
+// of the legs are each within FILTER_ERROR |v1| |v2| of the exact ones, which
+// moves the angle by no more than that, and atan2() here and the bounds of
+// angleOutsideBounds() add a few units of rounding.
+static const double ANGLE_ERROR = 4 * FILTER_ERROR;
+
+// Angle in [0, PI] at p2, from the dot and cross products of the legs like
+// angleOutsideBounds(), so that it is accurate near 0 and PI too.
+static double angleAt(const COORDINATE &p1, const COORDINATE &p2,
+                      const COORDINATE &p3) {
+  const double v1x = p1.x - p2.x, v1y = p1.y - p2.y;
+  const double v2x = p3.x - p2.x, v2y = p3.y - p2.y;
+  return std::atan2(std::fabs(v1x * v2y - v1y * v2x), v1x * v2x + v1y * v2y);
+}
+
+// Twice the area of the triangle, as twiceAreaSign() computes it, and the
+// error bound of its filter.
+static double twiceArea(const COORDINATE &p1, const COORDINATE &p2,
+                        const COORDINATE &p3, double &ERROR) {
+  const double left = (p2.x - p1.x) * (p3.y - p1.y);
+  const double right = (p2.y - p1.y) * (p3.x - p1.x);
+  ERROR = FILTER_ERROR * (std::fabs(left) + std::fabs(right));
+  return std::fabs(left - right);
+}
+
+// enclosingRadius() of the triangle, and a bound on its error and on that of
+// the radius fitsInCircle() compares in effect: a few units of rounding, and
+// for a circumcircle that of the cross product relative to it.
+static double radius(const COORDINATE &p1, const COORDINATE &p2,
+                     const COORDINATE &p3, double &ERROR) {
+  const double radius = enclosingRadius(p1, p2, p3);
+  const double ux = p2.x - p1.x, uy = p2.y - p1.y;
+  const double vx = p3.x - p1.x, vy = p3.y - p1.y;
+  const double wx = p3.x - p2.x, wy = p3.y - p2.y;
+  const double c2 = ux * ux + uy * uy;
+  const double b2 = vx * vx + vy * vy;
+  const double a2 = wx * wx + wy * wy;
+  const double longest2 = std::max(std::max(a2, b2), c2);
+  double relative = 1;
+  if (!(2 * longest2 >= a2 + b2 + c2)) {
+    const double left = ux * vy, right = uy * vx;
+    relative += (std::fabs(left) + std::fabs(right)) / std::fabs(left - right);
+  }
+  ERROR = FILTER_ERROR * radius * relative;
+  return radius;
+}
+
+// Largest distance in LIC 6 for one window of N_PTS consecutive points: the
+// distance of a point inside the window to the line through the first and
+// last point of the window, or to the first point if the two coincide. NaN if
+// any distance is NaN, and -infinity if N_PTS < 3. Sets ERROR to a bound on
+// the rounding error of the distances, so that the exact ones that
+// lic6Window() tests are within ERROR of those computed here.
+static double lic6MaxDistance(const COORDINATE *window, int N_PTS,
+                              double &ERROR) {
+  const COORDINATE &p1 = window[0];
+  const COORDINATE &p2 = window[N_PTS - 1];
+
+  bool coincident =
+      compareDoubles(p1.x, p2.x) == EQ && compareDoubles(p1.y, p2.y) == EQ;
+  double length =
+      std::sqrt(std::pow(p2.y - p1.y, 2) + std::pow(p2.x - p1.x, 2));
+
+  double max = -INFINITY;
+  ERROR = 0;
+  for (int j = 1; j < N_PTS - 1; ++j) {
+    const COORDINATE &p3 = window[j];
+    double distance;
+    double terms = 0;
+    if (coincident) {
+      distance = pointDistance(p1, p3);
+    } else {
+      // https://math.stackexchange.com/questions/2757318/distance-between-a-point-and-a-line-defined-by-2-points
+      const double left = (p2.x - p1.x) * (p3.y - p1.y);
+      const double right = (p3.x - p1.x) * (p2.y - p1.y);
+      distance = std::fabs(left - right) / length;
+      terms = (std::fabs(left) + std::fabs(right)) / length;
+    }
+    if (std::isnan(distance))
+      return distance;
+    max = std::max(max, distance);
+    ERROR = std::max(ERROR, FILTER_ERROR * (distance + terms));
+  }
+  return max;
+}
+
+BatchDecide::Extent::Extent()
+    : min(INFINITY), max(-INFINITY), nan(false), error(0) {}
+
+void BatchDecide::Extent::add(double value, double error) {
+  if (std::isnan(value)) {
+    nan = true;
+    return;
+  }
+  min = std::min(min, value);
+  max = std::max(max, value);
+  // "not greater than" so that a NaN error makes every threshold uncertain
+  if (!(error <= this->error))
+    this->error = std::isnan(error) ? INFINITY : error;
+}
+
+bool BatchDecide::Extent::empty() const { return min > max; }
+
+bool BatchDecide::Extent::anyAtLeast(double LIMIT) const {
+  return nan || (!empty() && max >= LIMIT);
+}
+
+bool BatchDecide::Extent::anyAtMost(double LIMIT) const {
+  return !empty() && min <= LIMIT;
+}
+
+bool BatchDecide::Extent::atLeastCertain(double LIMIT) const {
+  return nan || empty() ||
+         std::fabs(max - LIMIT) > error + FILTER_ERROR * std::fabs(LIMIT);
+}
+
+bool BatchDecide::Extent::atMostCertain(double LIMIT) const {
+  return empty() ||
+         std::fabs(min - LIMIT) > error + FILTER_ERROR * std::fabs(LIMIT);
+}
+
+BatchDecide::BatchDecide(int NUMPOINTS, const std::vector<COORDINATE> &POINTS)
+    : NUMPOINTS(NUMPOINTS), COORDINATES(POINTS),
+      cache(NUMPOINTS, POINTS_VIEW(COORDINATES.data())) {
+  const std::vector<COORDINATE> &P = COORDINATES;
+
+  const double *distance2 = cache.distance2(1);
+  for (int i = 0; i < cache.pairs(1); ++i) {
+    consecutive_distance.add(distance2[i], 0);
+  }
+  decreasing_x = cache.firstDecrease(1) >= 0;
+
+  for (int i = 0; i < NUMPOINTS - 2; ++i) {
+    const double angle = angleAt(P[i], P[i + 1], P[i + 2]);
+    if (validAngle(P[i], P[i + 1], P[i + 2]) && !std::isnan(angle))
+      consecutive_angle.add(angle, ANGLE_ERROR);
+    double error;
+    const double area = twiceArea(P[i], P[i + 1], P[i + 2], error);
+    consecutive_area.add(area, error);
+  }
+}
+
+int BatchDecide::maxQuadrants(int Q_PTS) {
+  std::map<int, int>::iterator it = max_quadrants.find(Q_PTS);
+  if (it != max_quadrants.end())
+    return it->second;
+
+  // Slide a Q_PTS window over the quadrant of each point, counting how many
+  // points of the window are in each quadrant.
+  const uint8_t *quadrants = cache.quadrants();
+  int best = 0;
+  if (Q_PTS > 0) {
+    QuadrantWindow window;
+    for (int i = 0; i < NUMPOINTS; ++i) {
+      window.add(quadrants[i]);
+      if (i >= Q_PTS)
+        window.remove(quadrants[i - Q_PTS]);
+      if (i + 1 >= Q_PTS)
+        best = std::max(best, window.occupied);
+    }
+  }
+  max_quadrants[Q_PTS] = best;
+  return best;
+}
+
+const BatchDecide::Extent &BatchDecide::lic6Distance(int N_PTS) {
+  std::map<int, Extent>::iterator it = lic6_distance.find(N_PTS);
+  if (it != lic6_distance.end())
+    return it->second;
+
+  Extent &extent = lic6_distance[N_PTS];
+  if (N_PTS >= 3) {
+    double error;
+    for (int i = 0; i + N_PTS <= NUMPOINTS; ++i) {
+      const double distance = lic6MaxDistance(&COORDINATES[i], N_PTS, error);
+      extent.add(distance, error);
+    }
+  }
+  return extent;
+}
+
+const BatchDecide::Extent &BatchDecide::gapDistance(int K_PTS) {
+  std::map<int, Extent>::iterator it = gap_distance.find(K_PTS);
+  if (it != gap_distance.end())
+    return it->second;
+
+  Extent &extent = gap_distance[K_PTS];
+  if (K_PTS >= 0) {
+    const double *distance2 = cache.distance2(K_PTS + 1);
+    for (int i = 0; i < cache.pairs(K_PTS + 1); ++i) {
+      extent.add(distance2[i], 0);
+    }
+  }
+  return extent;
+}
+
+const BatchDecide::Extent &BatchDecide::gapRadius(int A_PTS, int B_PTS) {
+  std::pair<int, int> key(A_PTS, B_PTS);
+  std::map<std::pair<int, int>, Extent>::iterator it = gap_radius.find(key);
+  if (it != gap_radius.end())
+    return it->second;
+
+  Extent &extent = gap_radius[key];
+  if (A_PTS >= 0 && B_PTS >= 0) {
+    double error;
+    for (int i = 0; i + A_PTS + B_PTS + 2 < NUMPOINTS; ++i) {
+      const double value =
+          radius(COORDINATES[i], COORDINATES[i + A_PTS + 1],
+                 COORDINATES[i + A_PTS + B_PTS + 2], error);
+      extent.add(value, error);
+    }
+  }
+  return extent;
+}
+
+const BatchDecide::Extent &BatchDecide::gapAngle(int C_PTS, int D_PTS) {
+  std::pair<int, int> key(C_PTS, D_PTS);
+  std::map<std::pair<int, int>, Extent>::iterator it = gap_angle.find(key);
+  if (it != gap_angle.end())
+    return it->second;
+
+  Extent &extent = gap_angle[key];
+  if (C_PTS >= 0 && D_PTS >= 0) {
+    for (int i = 0; i + C_PTS + D_PTS + 2 < NUMPOINTS; ++i) {
+      const COORDINATE &p1 = COORDINATES[i];
+      const COORDINATE &p2 = COORDINATES[i + C_PTS + 1];
+      const COORDINATE &p3 = COORDINATES[i + C_PTS + D_PTS + 2];
+      // A NaN angle is never outside the bounds, unlike a NaN distance.
+      const double angle = angleAt(p1, p2, p3);
+      if (validAngle(p1, p2, p3) && !std::isnan(angle))
+        extent.add(angle, ANGLE_ERROR);
+    }
+  }
+  return extent;
+}
+
+const BatchDecide::Extent &BatchDecide::gapArea(int E_PTS, int F_PTS) {
+  std::pair<int, int> key(E_PTS, F_PTS);
+  std::map<std::pair<int, int>, Extent>::iterator it = gap_area.find(key);
+  if (it != gap_area.end())
+    return it->second;
+
+  Extent &extent = gap_area[key];
+  if (E_PTS >= 0 && F_PTS >= 0) {
+    double error;
+    for (int i = 0; i + E_PTS + F_PTS + 2 < NUMPOINTS; ++i) {
+      const double area =
+          twiceArea(COORDINATES[i], COORDINATES[i + E_PTS + 1],
+                    COORDINATES[i + E_PTS + F_PTS + 2], error);
+      extent.add(area, error);
+    }
+  }
+  return extent;
+}
+
+bool BatchDecide::radiusAbove(const Extent &RADII, int gap1, int gap2,
+                              double RADIUS) {
+  // A radius compares GT to RADIUS if it is at least RADIUS + COMPARE_EPSILON.
+  const double limit = RADIUS + COMPARE_EPSILON;
+  if (RADII.atLeastCertain(limit))
+    return RADII.anyAtLeast(limit);
+  return firstRadiusAbove(cache.points(), NUMPOINTS, gap1, gap2, RADIUS) >= 0;
+}
+
+bool BatchDecide::radiusWithin(const Extent &RADII, int gap1, int gap2,
+                               double RADIUS) {
+  const double limit = RADIUS + COMPARE_EPSILON;
+  if (RADII.atMostCertain(limit))
+    return RADII.anyAtMost(limit);
+  return firstRadiusWithin(cache.points(), NUMPOINTS, gap1, gap2, RADIUS) >= 0;
+}
+
+bool BatchDecide::angleOutside(const Extent &ANGLES, int gap1, int gap2,
+                               double EPSILON) {
+  // The thresholds of angleBounds().
+  const double below = PI - EPSILON - COMPARE_EPSILON;
+  const double above = PI + EPSILON + COMPARE_EPSILON;
+  const bool any_below = ANGLES.anyAtMost(below);
+  const bool any_above = ANGLES.anyAtLeast(above);
+  const bool below_certain = ANGLES.atMostCertain(below);
+  const bool above_certain = ANGLES.atLeastCertain(above);
+  if ((any_below && below_certain) || (any_above && above_certain) ||
+      (below_certain && above_certain))
+    return any_below || any_above;
+  return firstAngleOutside(cache.points(), NUMPOINTS, gap1, gap2,
+                           angleBounds(EPSILON)) >= 0;
+}
+
+bool BatchDecide::areaAbove(const Extent &AREAS, int gap1, int gap2,
+                            double AREA) {
+  const double limit = greaterThanDoubled(AREA);
+  if (AREAS.atLeastCertain(limit))
+    return AREAS.anyAtLeast(limit);
+  return firstAreaAbove(cache.points(), NUMPOINTS, gap1, gap2, AREA) >= 0;
+}
+
+bool BatchDecide::areaBelow(const Extent &AREAS, int gap1, int gap2,
+                            double AREA) {
+  const double limit = lessThanDoubled(AREA);
+  if (AREAS.atMostCertain(limit))
+    return AREAS.anyAtMost(limit);
+  return firstAreaBelow(cache.points(), NUMPOINTS, gap1, gap2, AREA) >= 0;
+}
+
+DECISION_T BatchDecide::evaluate(const CONFIG_T &CONFIG) {
+  const PARAMETERS_T &P = CONFIG.PARAMETERS;
+  const int N = NUMPOINTS;
+  DECISION_T result;
+  std::array<bool, 15> &CMV = result.CMV;
+
+  CMV[0] = consecutive_distance.anyAtLeast(greaterThanSquared(P.LENGTH1));
+  CMV[1] = radiusAbove(gapRadius(0, 0), 1, 1, P.RADIUS1); // consecutive
+  CMV[2] = angleOutside(consecutive_angle, 1, 1, P.EPSILON);
+  CMV[3] = areaAbove(consecutive_area, 1, 1, P.AREA1);
+  CMV[4] = N >= P.Q_PTS && maxQuadrants(P.Q_PTS) > P.QUADS;
+  CMV[5] = decreasing_x;
+
+  // The distances are compared like the squared ones of lic6Window().
+  const Extent &lic6 = lic6Distance(P.N_PTS);
+  const double dist = P.DIST + COMPARE_EPSILON;
+  CMV[6] = N >= 3 &&
+           (lic6.atLeastCertain(dist)
+                ? lic6.anyAtLeast(dist)
+                : firstWindowAtLeast(cache.points(), N, P.N_PTS,
+                                     greaterThanSquared(P.DIST)) >= 0);
+
+  // Squared distances, the same values Decide compares.
+  const Extent &distance = gapDistance(P.K_PTS);
+  CMV[7] = N >= 3 && distance.anyAtLeast(greaterThanSquared(P.LENGTH1));
+
+  const int a = P.A_PTS + 1, b = P.B_PTS + 1;
+  const Extent &radii = gapRadius(P.A_PTS, P.B_PTS);
+  CMV[8] = N >= 5 && radiusAbove(radii, a, b, P.RADIUS1);
+
+  const Extent &angles = gapAngle(P.C_PTS, P.D_PTS);
+  CMV[9] = N >= 5 && angleOutside(angles, P.C_PTS + 1, P.D_PTS + 1, P.EPSILON);
+
+  const int e = P.E_PTS + 1, f = P.F_PTS + 1;
+  const Extent &areas = gapArea(P.E_PTS, P.F_PTS);
+  CMV[10] = N >= 5 && areaAbove(areas, e, f, P.AREA1);
+
+  CMV[11] = N >= 3 && cache.firstDecrease(P.G_PTS + 1) >= 0;
+  CMV[12] = CMV[7] && distance.anyAtMost(lessThanSquared(P.LENGTH2));
+  CMV[13] = CMV[8] && radiusWithin(radii, a, b, P.RADIUS2);
+  CMV[14] = CMV[10] && areaBelow(areas, e, f, P.AREA2);
+
+  result.LAUNCH = launchFromCMV(CMV, CONFIG.LCM, CONFIG.PUV);
+  return result;
+}
+
+std::vector<DECISION_T>
+BatchDecide::evaluate(const std::vector<CONFIG_T> &CONFIGS) {
+  std::vector<DECISION_T> results;
+  results.reserve(CONFIGS.size());
+  for (const CONFIG_T &CONFIG : CONFIGS) {
+    results.push_back(evaluate(CONFIG));
+  }
+  return results;
+}
@@ -0,0 +1,105 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "decide.h"
+#include "frame_cache.h"
+#include <cstdint>
+#include <map>
+#include <utility>
+
+/**
+ * @brief Evaluates many configurations (parameters, LCM and PUV) against the
+ * same set of points.
+ *
+ * Every LIC asks whether some window of points passes a threshold test that is
+ * monotone in one derived quantity (a distance, radius, area or angle). The
+ * quantities only depend on the points and on the gap parameters, so they are
+ * computed once per distinct gap and reduced to their smallest and largest
+ * value. A configuration then costs a handful of comparisons per LIC, no
+ * matter how many points there are.
+ *
+ * Decide compares squared distances in floating point and areas, LIC 6
+ * distances, radii and angles by the predicates of geometry.h. The extents
+ * keep the very squared distances Decide compares, and for the other
+ * quantities a bound on their rounding error. A threshold that the extreme
+ * value does not clear by that bound is decided by scanning the windows of
+ * that gap with the kernels Decide uses, so that every configuration gets the
+ * CMV of Decide, also on threshold cases.
+ */
+class BatchDecide {
+private:
+  // Smallest and largest value of a derived quantity over all windows. NaN
+  // values are left out of min/max; since the thresholds count NaN as above
+  // anything, they are remembered separately.
+  struct Extent {
+    double min;
+    double max;
+    bool nan;
+    // Largest bound on the rounding error of a value: the quantity the
+    // predicates of Decide test is within it of the value added.
+    double error;
+    Extent();
+    void add(double value, double error);
+    bool empty() const;
+    // Some value is not less (anyAtLeast) / not greater (anyAtMost) than
+    // LIMIT. A NaN one is at least anything.
+    bool anyAtLeast(double LIMIT) const;
+    bool anyAtMost(double LIMIT) const;
+    // Whether anyAtLeast() / anyAtMost() hold exactly when they do for the
+    // quantities Decide tests: the value they look at is farther from LIMIT
+    // than its error and the rounding of LIMIT.
+    bool atLeastCertain(double LIMIT) const;
+    bool atMostCertain(double LIMIT) const;
+  };
+
+  const int NUMPOINTS;
+  const std::vector<COORDINATE> COORDINATES;
+
+  // Distances, x differences and quadrants of the points, the same that
+  // Decide computes for them.
+  FrameCache cache;
+
+  // Derived quantities that do not depend on any parameter.
+  Extent consecutive_distance; // LIC 0, squared
+  Extent consecutive_angle;    // LIC 2, valid angles only
+  Extent consecutive_area;     // LIC 3, doubled
+  bool decreasing_x;           // LIC 5
+
+  // Derived quantities keyed by their gap parameters, filled on first use.
+  std::map<int, int> max_quadrants;                     // Q_PTS
+  std::map<int, Extent> lic6_distance;                  // N_PTS
+  std::map<int, Extent> gap_distance;                   // K_PTS, squared
+  std::map<std::pair<int, int>, Extent> gap_radius;     // A_PTS, B_PTS
+  std::map<std::pair<int, int>, Extent> gap_angle;      // C_PTS, D_PTS
+  std::map<std::pair<int, int>, Extent> gap_area;       // E_PTS, F_PTS
+
+  int maxQuadrants(int Q_PTS);
+  const Extent &lic6Distance(int N_PTS);
+  const Extent &gapDistance(int K_PTS);
+  const Extent &gapRadius(int A_PTS, int B_PTS);
+  const Extent &gapAngle(int C_PTS, int D_PTS);
+  const Extent &gapArea(int E_PTS, int F_PTS);
+
+  // Threshold tests of the triangles of points (i, i + gap1, i + gap1 + gap2)
+  // against their extent, scanning the windows where it is not certain.
+  bool radiusAbove(const Extent &RADII, int gap1, int gap2, double RADIUS);
+  bool radiusWithin(const Extent &RADII, int gap1, int gap2, double RADIUS);
+  bool angleOutside(const Extent &ANGLES, int gap1, int gap2, double EPSILON);
+  bool areaAbove(const Extent &AREAS, int gap1, int gap2, double AREA);
+  bool areaBelow(const Extent &AREAS, int gap1, int gap2, double AREA);
+
+public:
+  BatchDecide(int NUMPOINTS, const std::vector<COORDINATE> &POINTS);
+
+  // cache views COORDINATES, which a copy would not follow.
+  BatchDecide(const BatchDecide &) = delete;
+  BatchDecide &operator=(const BatchDecide &) = delete;
+
+  // CMV and launch decision for one configuration.
+  DECISION_T evaluate(const CONFIG_T &CONFIG);
+
+  // CMV and launch decision for each configuration, in the same order.
+  std::vector<DECISION_T> evaluate(const std::vector<CONFIG_T> &CONFIGS);
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <cmath>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Branch-free threshold tests with the semantics of compareDoubles(): values
+// closer than COMPARE_EPSILON are equal, and NaN is greater than anything.
+// The scalar forms combine their comparisons with bitwise operators, so that
+// loops over them have no data dependent branches; the SSE2 forms give the
+// same answer per lane, as an all-ones or all-zeros mask.
+
+// Tolerance used when comparing doubles, see compareDoubles().
+const double COMPARE_EPSILON = 0.000001;
+
+// compareDoubles(a, b) == GT
+inline bool greaterWithTolerance(double a, double b) {
+  return !((std::fabs(a - b) < COMPARE_EPSILON) | (a < b));
+}
+
+// compareDoubles(a, b) == LT
+inline bool lessWithTolerance(double a, double b) {
+  return (a < b) & !(std::fabs(a - b) < COMPARE_EPSILON);
+}
+
+#if defined(__SSE2__)
+// |a - b| < COMPARE_EPSILON per lane.
+inline __m128d nearMask(__m128d a, __m128d b) {
+  const __m128d magnitude = _mm_andnot_pd(_mm_set1_pd(-0.0), _mm_sub_pd(a, b));
+  return _mm_cmplt_pd(magnitude, _mm_set1_pd(COMPARE_EPSILON));
+}
+
+// greaterWithTolerance() per lane.
+inline __m128d greaterMask(__m128d a, __m128d b) {
+  const __m128d not_greater = _mm_or_pd(nearMask(a, b), _mm_cmplt_pd(a, b));
+  return _mm_xor_pd(not_greater, _mm_castsi128_pd(_mm_set1_epi32(-1)));
+}
+
+// lessWithTolerance() per lane.
+inline __m128d lessMask(__m128d a, __m128d b) {
+  return _mm_andnot_pd(nearMask(a, b), _mm_cmplt_pd(a, b));
+}
+#endif
+
+#endif
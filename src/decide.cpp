@@ -1,13 +1,14 @@
 #include "decide.h"
+#include "geometry.h"
+#include "instrument.h"
+#include "kernels.h"
+#include "parallel.h"
+#include "unlock.h"
 #include <cmath>
 #include <cstdio>
 
 COMPTYPE Decide::DOUBLECOMPARE(double a, double b) const {
-  if (fabs(a - b) < 0.000001)
-    return EQ;
-  if (a < b)
-    return LT;
-  return GT;
+  return compareDoubles(a, b);
 }
 
 /// @brief Computes the angle (in degrees) between three points, where the
@@ -19,26 +20,7 @@ COMPTYPE Decide::DOUBLECOMPARE(double a, double b) const {
 
 double Decide::COMPUTEANLGE(const COORDINATE &point1, const COORDINATE &point2,
                             const COORDINATE &point3) {
-  // calculate vectors to form the angle
-  COORDINATE v1 = {point1.x - point2.x,
-                   point1.y - point2.y}; // vector from p2 to p1
-  COORDINATE v2 = {point3.x - point2.x,
-                   point3.y - point2.y}; // vector from p2 to p3
-
-  // using dot product formula to get the angle:
-  // calculate the vector multiplication
-  double dot_product = v1.x * v2.x + v1.y * v2.y;
-
-  // calcualte the vectors magnitude
-  double magnitude_v1 = std::sqrt(std::pow(v1.x, 2) + std::pow(v1.y, 2));
-  double magnitude_v2 = std::sqrt(std::pow(v2.x, 2) + std::pow(v2.y, 2));
-
-  // get the angle from the dot product formula
-  double angle = std::acos(dot_product / (magnitude_v1 * magnitude_v2));
-
-  // convert angle from radians to degrees
-  // angle = angle * 180.0 / PI;
-  return angle;
+  return computeAngle(point1, point2, point3);
 }
 
 /// @brief Validates that an angle can be made with the three points provided
@@ -49,24 +31,57 @@ double Decide::COMPUTEANLGE(const COORDINATE &point1, const COORDINATE &point2,
 /// undefined
 bool Decide::VALIDATEANGLE(const COORDINATE &point1, const COORDINATE &point2,
                            const COORDINATE &point3) {
-  // return ((point1.x == point2.x && point1.y == point2.y) ||
-  //         (point3.x == point2.x && point3.y == point2.y));
+  return validAngle(point1, point2, point3);
+}
 
-  return ((point1.x != point2.x || point1.y != point2.y) &&
-          (point3.x != point2.x || point3.y != point2.y));
+// Records in PROBE where a kernel scan over WINDOWS windows stopped, FIRST
+// being the window that met the condition or -1. Returns whether one did.
+static bool scanned(Probe &PROBE, int FIRST, int WINDOWS) {
+  if (FIRST < 0) {
+    PROBE.visit(WINDOWS);
+    return false;
+  }
+  PROBE.exitAt(FIRST);
+  return true;
 }
 
+// Gaps the LICs and debugprint() take from the cache: 1, K_PTS + 1 and
+// G_PTS + 1.
+static const int CACHE_GAPS = 3;
+
 Decide::Decide(int NUMPOINTS, const std::vector<COORDINATE> &POINTS,
                const PARAMETERS_T &PARAMETERS,
                const std::array<std::array<CONNECTORS, 15>, 15> &LCM,
                const std::array<bool, 15> &PUV)
+    : NUMPOINTS(NUMPOINTS), OWNED_COORDINATES(POINTS),
+      COORDINATES(OWNED_COORDINATES), PARAMETERS(PARAMETERS), LCM(LCM),
+      PUV(PUV), CACHE(NUMPOINTS, COORDINATES),
+      KERNELS(gapKernels(PARAMETERS)),
+      ANGLE_BOUNDS(angleBounds(PARAMETERS.EPSILON)) {
+  CACHE.reserve(NUMPOINTS, CACHE_GAPS);
+}
+
+Decide::Decide(int NUMPOINTS, const POINTS_VIEW &POINTS,
+               const PARAMETERS_T &PARAMETERS,
+               const std::array<std::array<CONNECTORS, 15>, 15> &LCM,
+               const std::array<bool, 15> &PUV)
     : NUMPOINTS(NUMPOINTS), COORDINATES(POINTS), PARAMETERS(PARAMETERS),
-      LCM(LCM), PUV(PUV) {}
+      LCM(LCM), PUV(PUV), CACHE(NUMPOINTS, COORDINATES),
+      KERNELS(gapKernels(PARAMETERS)),
+      ANGLE_BOUNDS(angleBounds(PARAMETERS.EPSILON)) {
+  CACHE.reserve(NUMPOINTS, CACHE_GAPS);
+}
 
 void Decide::debugprint() const {
-  printf("Coordinates (x, y):\n");
+  printf("Coordinates (x, y), quadrant and distance to the next point:\n");
+  const uint8_t *quadrants = CACHE.quadrants();
+  const double *distance2 = CACHE.distance2(1);
   for (int i = 0; i < NUMPOINTS; ++i) {
-    printf("\t(%f, %f)\n", COORDINATES[i].x, COORDINATES[i].y);
+    printf("\t(%f, %f) %d", COORDINATES[i].x, COORDINATES[i].y,
+           quadrants[i] + 1);
+    if (i + 1 < NUMPOINTS)
+      printf(" %f", std::sqrt(distance2[i]));
+    printf("\n");
   }
 
   printf("\nParameters:\n");
@@ -148,6 +163,10 @@ void Decide::Calc_CMV() {
   Decide::CMV[14] = Lic14();
 }
 
+void Decide::Calc_CMV(ThreadPool &POOL) {
+  CMV = parallelCMV(POOL, NUMPOINTS, COORDINATES, PARAMETERS);
+}
+
 /**
  * @brief There exists at least one set of two consecutive data points that are
  a distance greater than the length, LENGTH1, apart. (0 ≤ LENGTH1)
@@ -157,19 +176,12 @@ void Decide::Calc_CMV() {
  */
 
 bool Decide::Lic0() {
-  // Iterate through consecutive pairs of points
-  for (int i = 0; i < NUMPOINTS - 1; ++i) {
-    // Calculate the distance between consecutive points
-    double distance = sqrt(pow(COORDINATES[i + 1].x - COORDINATES[i].x, 2) +
-                           pow(COORDINATES[i + 1].y - COORDINATES[i].y, 2));
-
-    // Check if the distance is greater than LENGTH1
-    if (DOUBLECOMPARE(distance, PARAMETERS.LENGTH1) == GT) {
-      // Set the corresponding CMV element to true
-      return true;
-    }
-  }
-  return false;
+  Probe probe(0);
+  // Compare the distance of every consecutive pair against LENGTH1
+  return scanned(probe,
+                 CACHE.firstDistanceAtLeast(
+                     1, greaterThanSquared(PARAMETERS.LENGTH1)),
+                 NUMPOINTS - 1);
 }
 
 /**
@@ -177,38 +189,16 @@ bool Decide::Lic0() {
  * cannot all be contained within or on a circle of radius RADIUS1.
  * (0 ≤ RADIUS1)
  *
- * https://artofproblemsolving.com/wiki/index.php/Circumradius
+ * The smallest circle around the points is their circumcircle, or the circle
+ * on the longest side if they do not form an acute triangle, see
+ * enclosingRadius().
  */
 
 bool Decide::Lic1() {
-  for (int i = 0; i < NUMPOINTS - 2; ++i) {
-    COORDINATE p1 = COORDINATES[i];
-    COORDINATE p2 = COORDINATES[i + 1];
-    COORDINATE p3 = COORDINATES[i + 2];
-
-    // find the size of the triangle
-    double a = sqrt(pow(p1.x - p2.x, 2) + pow(p1.y - p2.y, 2));
-    double b = sqrt(pow(p2.x - p3.x, 2) + pow(p2.y - p3.y, 2));
-    double c = sqrt(pow(p3.x - p1.x, 2) + pow(p3.y - p1.y, 2));
-
-    double s = (a + b + c) / 2;
-
-    double area = sqrt(s * (s - a) * (s - b) * (s - c)); // Heron's formula
-
-    if (DOUBLECOMPARE(area, 0) == EQ) {
-      double max = std::max(std::max(a, b), c);
-      if (DOUBLECOMPARE(max, PARAMETERS.RADIUS1) == GT) {
-        return true;
-      }
-    } else {
-      double r = (a * b * c) / (4 * area); // radius of the circumcircle
-
-      if (DOUBLECOMPARE(r, PARAMETERS.RADIUS1) == GT) {
-        return true;
-      }
-    }
-  }
-  return false;
+  Probe probe(1);
+  return scanned(
+      probe, firstRadiusAbove(COORDINATES, NUMPOINTS, 1, 1, PARAMETERS.RADIUS1),
+      NUMPOINTS - 2);
 }
 
 /**
@@ -226,32 +216,13 @@ bool Decide::Lic1() {
 bool Decide::Lic2() {
   // CONDITION: find three consecutive data points to form an angle with
   //            angle needs to be in range to enable LIC
-  const double &EPSILON = PARAMETERS.EPSILON;
-
-  // -2 to prevent index error
-  for (int i = 0; i < NUMPOINTS - 2; ++i) {
-    // create reference to coordinates, const to protect changes
-    const COORDINATE &point1 = COORDINATES[i];
-    const COORDINATE &point2 = COORDINATES[i + 1];
-    const COORDINATE &point3 = COORDINATES[i + 2];
-
-    // the second point is the "vertex", if any point coincides with it
-    // the angle is undefined, therfore is invalid
-    if (VALIDATEANGLE(point1, point2, point3) == false) {
-      continue;
-    }
-    // otherwise...
-    double angle = COMPUTEANLGE(point1, point2, point3);
-    // using DOUBLECOMPARE to check angle against pi - epsilon
-    if ((DOUBLECOMPARE(angle, PI - EPSILON) == LT ||
-         DOUBLECOMPARE(angle, PI + EPSILON) == GT)) {
-      // we found a valid angle! set corresponding CMV to true
-      return true;
-    }
-  }
+  Probe probe(2);
 
-  // set the corresponding Conditions Met Vector
-  return false;
+  // The second point is the "vertex". If any point coincides with it the
+  // angle is undefined, and therefore not outside.
+  return scanned(probe,
+                 firstAngleOutside(COORDINATES, NUMPOINTS, 1, 1, ANGLE_BOUNDS),
+                 NUMPOINTS - 2);
 }
 
 /**
@@ -263,27 +234,10 @@ bool Decide::Lic2() {
  */
 
 bool Decide::Lic3() {
-  bool found_greater_area = false;
-
-  for (size_t i = 0; i < COORDINATES.size() - 2; ++i) {
-    COORDINATE c1 = COORDINATES[i];
-    COORDINATE c2 = COORDINATES[i + 1];
-    COORDINATE c3 = COORDINATES[i + 2];
-
-    // Formula from:
-    // https://www.cuemath.com/geometry/area-of-triangle-in-coordinate-geometry/
-    double area = 0.5 * fabs(c1.x * (c2.y - c3.y) + c2.x * (c3.y - c1.y) +
-                             c3.x * (c1.y - c2.y));
-
-    COMPTYPE comp = DOUBLECOMPARE(area, PARAMETERS.AREA1);
-
-    if (comp == GT) {
-      found_greater_area = true;
-      break;
-    }
-  }
-
-  return found_greater_area;
+  Probe probe(3);
+  return scanned(probe,
+                 firstAreaAbove(COORDINATES, NUMPOINTS, 1, 1, PARAMETERS.AREA1),
+                 NUMPOINTS - 2);
 }
 
 /**
@@ -301,44 +255,15 @@ bool Decide::Lic3() {
  */
 
 bool Decide::Lic4() {
+  Probe probe(4);
   if (NUMPOINTS < PARAMETERS.Q_PTS)
     return false;
 
-  for (int i = 0; i < NUMPOINTS - PARAMETERS.Q_PTS + 1; i++) {
-    bool quadrants[4];
-    for (int k = 0; k < 4; k++) {
-      quadrants[k] = false;
-    }
-
-    int count = 0;
-    for (int j = 0; j < PARAMETERS.Q_PTS; j++) {
-      COORDINATE p = COORDINATES[i + j];
-      // if (p.x >= 0) {
-      if (DOUBLECOMPARE(p.x, 0.0) != LT) {
-        // if (p.y >= 0) {
-        if (DOUBLECOMPARE(p.y, 0.0) != LT) {
-          quadrants[0] = true;
-        } else {
-          quadrants[3] = true;
-        }
-      } else {
-        if (DOUBLECOMPARE(p.y, 0.0) != LT) {
-          quadrants[1] = true;
-        } else {
-          quadrants[2] = true;
-        }
-      }
-    }
-    for (bool q : quadrants) {
-      if (q) {
-        count += 1;
-      }
-    }
-    if (count > PARAMETERS.QUADS) {
-      return true;
-    }
-  }
-  return false;
+  // Classify every point once, then slide the window over the quadrants.
+  return scanned(probe,
+                 firstQuadrantWindow(CACHE.quadrants(), NUMPOINTS,
+                                     PARAMETERS.Q_PTS, PARAMETERS.QUADS),
+                 NUMPOINTS - PARAMETERS.Q_PTS + 1);
 }
 
 /**
@@ -349,16 +274,9 @@ bool Decide::Lic4() {
  * @return false
  */
 bool Decide::Lic5() {
-  // Iterate through consecutive pairs of data points
-  for (int i = 0; i < NUMPOINTS - 1; i++) {
-    //// Check if X[j] - X[i] < 0
-    if (DOUBLECOMPARE(COORDINATES[i + 1].x - COORDINATES[i].x, 0) == LT) {
-      // The condition is met, set CMV[4] to true
-      return true;
-    }
-  }
-
-  return false;
+  Probe probe(5);
+  // Check if X[j] - X[i] < 0 for consecutive pairs of data points
+  return scanned(probe, CACHE.firstDecrease(1), NUMPOINTS - 1);
 }
 
 /**
@@ -371,47 +289,16 @@ bool Decide::Lic5() {
  *
  */
 bool Decide::Lic6() {
+  Probe probe(6);
   if (NUMPOINTS < 3) {
     return false;
   }
 
-  for (int i = 0; i < NUMPOINTS - PARAMETERS.N_PTS + 1; ++i) {
-    COORDINATE p1 = COORDINATES[i];
-    COORDINATE p2 = COORDINATES[i + PARAMETERS.N_PTS];
-
-    if (DOUBLECOMPARE(p1.x, p2.x) == EQ && DOUBLECOMPARE(p1.y, p2.y) == EQ) {
-      // p1 and p2 are the same point
-      for (int j = 0; j < NUMPOINTS; ++j) {
-        if (j == i)
-          continue;
-
-        COORDINATE p3 = COORDINATES[j];
-
-        double distance = sqrt(pow(p3.x - p1.x, 2) + pow(p3.y - p1.y, 2));
-
-        if (DOUBLECOMPARE(distance, PARAMETERS.DIST) == GT) {
-          return true;
-        }
-      }
-    } else {
-      // p1 and p2 are different points
-      for (int j = 0; j < NUMPOINTS; ++j) {
-        if (j == i || j == i + PARAMETERS.N_PTS - 1)
-          continue;
-
-        COORDINATE p3 = COORDINATES[j];
-        // https://math.stackexchange.com/questions/2757318/distance-between-a-point-and-a-line-defined-by-2-points
-        double distance = fabs((p2.x - p1.x) * (p3.y - p1.y) -
-                               (p3.x - p1.x) * (p2.y - p1.y)) /
-                          sqrt(pow(p2.y - p1.y, 2) + pow(p2.x - p1.x, 2));
-
-        if (DOUBLECOMPARE(distance, PARAMETERS.DIST) == GT) {
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+  // Only the N_PTS points of each window are compared against its line.
+  return scanned(probe,
+                 firstWindowAtLeast(COORDINATES, NUMPOINTS, PARAMETERS.N_PTS,
+                                    greaterThanSquared(PARAMETERS.DIST)),
+                 NUMPOINTS - PARAMETERS.N_PTS + 1);
 }
 
 /**
@@ -427,27 +314,19 @@ bool Decide::Lic6() {
 bool Decide::Lic7() {
   // create references
   const int &K_PTS = PARAMETERS.K_PTS;
+  Probe probe(7);
 
   // condition not met when NUMPOINTS less than three
-  if (NUMPOINTS >= 3) {
-    // we need to check two data points seperated by K_PTS steps
-    // reduce number of points to explore to prevent index error
-    for (int i = 0; i < NUMPOINTS - K_PTS - 1; i++) {
-      // get the difference between current coordinate and coordinate K_PTS + 1
-      // points ahead K_PTS + 1 because we want exactly K_PTS points BETWEEN, so
-      // K_PTS nodes between i and i + (K_PTS + 1)
-      double dx = COORDINATES[i + K_PTS + 1].x - COORDINATES[i].x;
-      double dy = COORDINATES[i + K_PTS + 1].y - COORDINATES[i].y;
-      double distance = std::sqrt(std::pow(dx, 2) + std::pow(dy, 2));
-
-      if (DOUBLECOMPARE(distance, PARAMETERS.LENGTH1) == GT) {
-        return true;
-      }
-    }
+  if (NUMPOINTS < 3) {
+    return false;
   }
 
-  // set the corresponding Conditions Met Vector
-  return false;
+  // K_PTS + 1 because we want exactly K_PTS points BETWEEN, so K_PTS nodes
+  // between i and i + (K_PTS + 1)
+  return scanned(probe,
+                 CACHE.firstDistanceAtLeast(
+                     K_PTS + 1, greaterThanSquared(PARAMETERS.LENGTH1)),
+                 NUMPOINTS - K_PTS - 1);
 }
 
 /**
@@ -462,43 +341,17 @@ bool Decide::Lic7() {
  */
 
 bool Decide::Lic8() {
+  Probe probe(8);
   if (NUMPOINTS < 5) {
     return false;
   }
 
-  bool found_larger_triangle = false;
-
-  auto dist_lambda = [](const COORDINATE &a, const COORDINATE &b) -> double {
-    return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
-  };
-
-  for (int i = 0; i < NUMPOINTS; ++i) {
-    if (i + PARAMETERS.A_PTS + PARAMETERS.B_PTS + 2 >= NUMPOINTS) {
-      break;
-    }
-
-    COORDINATE c1 = COORDINATES[i];
-    COORDINATE c2 = COORDINATES[i + PARAMETERS.A_PTS + 1];
-    COORDINATE c3 = COORDINATES[i + PARAMETERS.A_PTS + PARAMETERS.B_PTS + 2];
-
-    double a = dist_lambda(c1, c2);
-    double b = dist_lambda(c1, c3);
-    double c = dist_lambda(c2, c3);
-
-    // Based on this formula:
-    // https://mathworld.wolfram.com/Circumradius.html
-    double circumradius = (a * b * c) / sqrt((a + b + c) * (b + c - a) *
-                                             (c + a - b) * (a + b - c));
-
-    COMPTYPE comp = DOUBLECOMPARE(circumradius, PARAMETERS.RADIUS1);
-
-    if (comp == GT) {
-      found_larger_triangle = true;
-      break;
-    }
-  }
-
-  return found_larger_triangle;
+  // Triangles of points (i, i + A_PTS + 1, i + A_PTS + B_PTS + 2)
+  return scanned(probe,
+                 KERNELS.radius_above(COORDINATES, NUMPOINTS,
+                                      PARAMETERS.A_PTS + 1,
+                                      PARAMETERS.B_PTS + 1, PARAMETERS.RADIUS1),
+                 NUMPOINTS - PARAMETERS.A_PTS - PARAMETERS.B_PTS - 2);
 }
 
 /**
@@ -515,28 +368,17 @@ bool Decide::Lic8() {
  */
 
 bool Decide::Lic9() {
+  Probe probe(9);
   if (NUMPOINTS < 5)
     return false;
-  std::vector<COORDINATE> a;
-  for (int i = 0; i < NUMPOINTS - 2 - PARAMETERS.C_PTS - PARAMETERS.D_PTS;
-       i++) {
-    a.clear();
-    a.push_back(COORDINATES[i]);
-    a.push_back(COORDINATES[i + PARAMETERS.C_PTS + 1]);
-    a.push_back(COORDINATES[i + PARAMETERS.C_PTS + PARAMETERS.D_PTS + 2]);
-
-    if (VALIDATEANGLE(a[0], a[1], a[2]) == false)
-      continue;
-
-    double angle = COMPUTEANLGE(a[0], a[1], a[2]);
-
-    if (DOUBLECOMPARE(angle, PI - PARAMETERS.EPSILON) == LT ||
-        DOUBLECOMPARE(angle, PI + PARAMETERS.EPSILON) == GT) {
-      return true;
-    }
-  }
 
-  return false;
+  // Angles at point i + C_PTS + 1 of points (i, i + C_PTS + 1,
+  // i + C_PTS + D_PTS + 2)
+  return scanned(probe,
+                 KERNELS.angle_outside(COORDINATES, NUMPOINTS,
+                                       PARAMETERS.C_PTS + 1,
+                                       PARAMETERS.D_PTS + 1, ANGLE_BOUNDS),
+                 NUMPOINTS - 2 - PARAMETERS.C_PTS - PARAMETERS.D_PTS);
 }
 
 /**
@@ -551,29 +393,18 @@ bool Decide::Lic9() {
  */
 
 bool Decide::Lic10() {
+  Probe probe(10);
   if (NUMPOINTS < 5) {
     return false;
   }
 
-  for (int i = 0; i < NUMPOINTS; ++i) {
-
-    if (i + PARAMETERS.E_PTS + PARAMETERS.F_PTS + 2 >= NUMPOINTS) {
-      break;
-    }
-
-    COORDINATE c1 = COORDINATES[i];
-    COORDINATE c2 = COORDINATES[i + PARAMETERS.E_PTS + 1];
-    COORDINATE c3 = COORDINATES[i + PARAMETERS.E_PTS + PARAMETERS.F_PTS + 2];
-
-    // Calculate the area of the triangle formed by points (i, j, k)
-    double area = 0.5 * fabs(c1.x * (c2.y - c3.y) + c2.x * (c3.y - c1.y) +
-                             c3.x * (c1.y - c2.y));
-    if (DOUBLECOMPARE(area, PARAMETERS.AREA1) == GT) {
-      // Set CMV[9] to true if condition is met
-      return true;
-    }
-  }
-  return false;
+  // Area of the triangle formed by points (i, i + E_PTS + 1,
+  // i + E_PTS + F_PTS + 2)
+  return scanned(probe,
+                 KERNELS.area_above(COORDINATES, NUMPOINTS,
+                                    PARAMETERS.E_PTS + 1, PARAMETERS.F_PTS + 1,
+                                    PARAMETERS.AREA1),
+                 NUMPOINTS - PARAMETERS.E_PTS - PARAMETERS.F_PTS - 2);
 }
 
 /**
@@ -584,20 +415,13 @@ bool Decide::Lic10() {
  *
  */
 bool Decide::Lic11() {
+  Probe probe(11);
   if (NUMPOINTS < 3) {
     return false;
   }
 
-  for (int i = 0; i < NUMPOINTS - PARAMETERS.G_PTS - 1; ++i) {
-    COORDINATE p1 = COORDINATES[i];
-    COORDINATE p2 = COORDINATES[i + PARAMETERS.G_PTS + 1];
-
-    if (DOUBLECOMPARE(p2.x - p1.x, 0) == LT) {
-      return true;
-    }
-  }
-
-  return false;
+  return scanned(probe, CACHE.firstDecrease(PARAMETERS.G_PTS + 1),
+                 NUMPOINTS - PARAMETERS.G_PTS - 1);
 }
 
 /**
@@ -614,48 +438,25 @@ bool Decide::Lic11() {
  */
 
 bool Decide::Lic12() {
-  // create flags for both conditions
-  bool condition1 = false;
-  bool condition2 = false;
   // create reference
   const int &K_PTS = PARAMETERS.K_PTS;
+  Probe probe(12);
 
   // if numpoints < 3, stop!
   if (NUMPOINTS < 3) {
     return false;
   }
 
-  // CODE REUSED FROM LIC7
-  for (int i = 0; i < NUMPOINTS - K_PTS - 1; i++) {
-    double dx = COORDINATES[i + K_PTS + 1].x - COORDINATES[i].x;
-    double dy = COORDINATES[i + K_PTS + 1].y - COORDINATES[i].y;
-    double distance = std::sqrt(std::pow(dx, 2) + std::pow(dy, 2));
-
-    // check condition one
-    if (DOUBLECOMPARE(distance, PARAMETERS.LENGTH1) == GT) {
-      condition1 = true;
-      break;
-    }
-  }
-
-  for (int i = 0; i < NUMPOINTS - K_PTS - 1; i++) {
-    double dx = COORDINATES[i + K_PTS + 1].x - COORDINATES[i].x;
-    double dy = COORDINATES[i + K_PTS + 1].y - COORDINATES[i].y;
-    double distance = std::sqrt(std::pow(dx, 2) + std::pow(dy, 2));
-
-    // check condition two
-    if (DOUBLECOMPARE(distance, PARAMETERS.LENGTH2) == LT) {
-      condition2 = true;
-      break;
-    }
-  }
-
-  // LIC is true only if both conditions are fulfilled
-  if (condition1 == true && condition2 == true) {
-    return true;
-  } else {
-    return false;
-  }
+  // LIC is true only if both conditions are fulfilled, as in Lic13() by
+  // different pairs. The distances are those of LIC 7, computed once for both.
+  const int larger = CACHE.firstDistanceAtLeast(
+      K_PTS + 1, greaterThanSquared(PARAMETERS.LENGTH1));
+  const int smaller =
+      larger < 0 ? -1
+                 : CACHE.firstDistanceAtMost(
+                       K_PTS + 1, lessThanSquared(PARAMETERS.LENGTH2));
+  return scanned(probe, smaller < 0 ? -1 : std::max(larger, smaller),
+                 NUMPOINTS - K_PTS - 1);
 }
 
 /**
@@ -674,52 +475,23 @@ condition is not met when NUMPOINTS < 5. 0 ≤ RADIUS2
  */
 
 bool Decide::Lic13() {
+  Probe probe(13);
   if (NUMPOINTS < 5) {
     return false;
   }
 
-  bool found_larger_triangle = false;
-  bool found_smaller_triangle = false;
-
-  auto dist_lambda = [](const COORDINATE &a, const COORDINATE &b) -> double {
-    return sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
-  };
-
-  for (int i = 0; i < NUMPOINTS; ++i) {
-    if (i + PARAMETERS.A_PTS + PARAMETERS.B_PTS + 2 >= NUMPOINTS) {
-      break;
-    }
-
-    COORDINATE c1 = COORDINATES[i];
-    COORDINATE c2 = COORDINATES[i + PARAMETERS.A_PTS + 1];
-    COORDINATE c3 = COORDINATES[i + PARAMETERS.A_PTS + PARAMETERS.B_PTS + 2];
-
-    double a = dist_lambda(c1, c2);
-    double b = dist_lambda(c1, c3);
-    double c = dist_lambda(c2, c3);
-
-    // Based on this formula:
-    // https://mathworld.wolfram.com/Circumradius.html
-    double circumradius = (a * b * c) / sqrt((a + b + c) * (b + c - a) *
-                                             (c + a - b) * (a + b - c));
-
-    COMPTYPE comp1 = DOUBLECOMPARE(circumradius, PARAMETERS.RADIUS1);
-    COMPTYPE comp2 = DOUBLECOMPARE(circumradius, PARAMETERS.RADIUS2);
-
-    if (comp1 == GT) {
-      found_larger_triangle = true;
-    }
-
-    if (comp2 != GT) {
-      found_smaller_triangle = true;
-    }
-
-    if (found_larger_triangle && found_smaller_triangle) {
-      break;
-    }
-  }
-
-  return found_smaller_triangle && found_larger_triangle;
+  // The two triangles can be different ones, so the LIC is met at the later
+  // of the first triangle of each kind.
+  const int gap1 = PARAMETERS.A_PTS + 1;
+  const int gap2 = PARAMETERS.B_PTS + 1;
+  const int larger = KERNELS.radius_above(COORDINATES, NUMPOINTS, gap1, gap2,
+                                          PARAMETERS.RADIUS1);
+  const int smaller =
+      larger < 0 ? -1
+                 : KERNELS.radius_within(COORDINATES, NUMPOINTS, gap1, gap2,
+                                         PARAMETERS.RADIUS2);
+  return scanned(probe, smaller < 0 ? -1 : std::max(larger, smaller),
+                 NUMPOINTS - PARAMETERS.A_PTS - PARAMETERS.B_PTS - 2);
 }
 
 /**
@@ -738,90 +510,55 @@ bool Decide::Lic13() {
  */
 
 bool Decide::Lic14() {
+  Probe probe(14);
   if (NUMPOINTS < 5)
     return false;
-  std::vector<COORDINATE> a;
-  // conditions can be fullfilled by multiple different points in the array
-  bool area1_condition = false;
-  bool area2_condition = false;
-
-  for (int i = 0; i < NUMPOINTS - 2 - PARAMETERS.E_PTS - PARAMETERS.F_PTS;
-       i++) {
-    a.clear();
-    a.push_back(COORDINATES[i]);
-    a.push_back(COORDINATES[i + PARAMETERS.E_PTS + 1]);
-    a.push_back(COORDINATES[i + PARAMETERS.E_PTS + PARAMETERS.F_PTS + 2]);
-    double area = fabs(a[0].x * a[1].y + a[1].x * a[2].y + a[2].x * a[0].y -
-                       a[0].x * a[2].y - a[1].x * a[0].y - a[2].x * a[1].y) /
-                  2;
-
-    // check for area condition 1
-    if (DOUBLECOMPARE(area, PARAMETERS.AREA1) == GT) {
-      area1_condition = true;
-    }
-    // check for area condition 2
-    if (DOUBLECOMPARE(area, PARAMETERS.AREA2) == LT) {
-      area2_condition = true;
-    }
-    // if both have been fullfilled at some point, return true
-    if (area1_condition == true && area2_condition == true) {
-      return true;
-    }
-  }
-  return false;
+
+  // As in Lic13(), the areas can be met by different triangles.
+  const int gap1 = PARAMETERS.E_PTS + 1;
+  const int gap2 = PARAMETERS.F_PTS + 1;
+  const int larger = KERNELS.area_above(COORDINATES, NUMPOINTS, gap1, gap2,
+                                        PARAMETERS.AREA1);
+  const int smaller =
+      larger < 0 ? -1
+                 : KERNELS.area_below(COORDINATES, NUMPOINTS, gap1, gap2,
+                                      PARAMETERS.AREA2);
+  return scanned(probe, smaller < 0 ? -1 : std::max(larger, smaller),
+                 NUMPOINTS - 2 - PARAMETERS.E_PTS - PARAMETERS.F_PTS);
 }
 
 void Decide::Calc_PUM() {
-  for (int x = 0; x < 15; ++x) {
-    for (int y = 0; y < 15; ++y) {
-      if (x == y) {
-        PUM[y][x] = true;
-        continue;
-      }
-
-      switch (LCM[y][x]) {
-      case ANDD:
-        PUM[y][x] = CMV[y] && CMV[x];
-        break;
-
-      case ORR:
-        PUM[y][x] = CMV[y] || CMV[x];
-        break;
-
-      default: // NOTUSED
-        PUM[y][x] = true;
-        break;
-      }
-    }
-  }
+  Probe probe(PROBE_CALC_PUM);
+  calcPUM(CMV, LCM, PUM);
 }
 
 void Decide::Calc_FUV() {
-  bool a;
-  for (int j = 0; j < 15; j++) {
-    a = PUM[0][j];
-    for (int i = 1; i < 15; i++) {
-      a &= PUM[i][j];
-    }
-    FUV[j] = (!PUV[j]) || a;
-  }
-};
+  Probe probe(PROBE_CALC_FUV);
+  calcFUV(PUM, PUV, FUV);
+}
 
 void Decide::decide() {
   Calc_CMV();
+  Calc_Decision();
+}
+
+void Decide::decide(ThreadPool &POOL) {
+  Calc_CMV(POOL);
+  Calc_Decision();
+}
+
+void Decide::Calc_Decision() {
   Calc_PUM();
   Calc_FUV();
   Calc_LAUNCH();
   if (LAUNCH) {
-    std::cout << "YES" << std::endl;
+    std::cout << "YES\n";
   } else {
-    std::cout << "NO" << std::endl;
+    std::cout << "NO\n";
   }
 }
 
 void Decide::Calc_LAUNCH() {
-  LAUNCH = true;
-  for (int i = 0; i < 15; ++i) {
-    LAUNCH = LAUNCH && FUV[i];
-  }
+  Probe probe(PROBE_CALC_LAUNCH);
+  LAUNCH = calcLAUNCH(FUV);
 }
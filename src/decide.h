@@ -1,6 +1,9 @@
 #ifndef DECIDE_H
 #define DECIDE_H
 
+#include "frame_cache.h"
+#include "kernels.h"
+#include "points.h"
 #include "gtest/gtest.h"
 #include <array>
 #include <vector>
@@ -12,10 +15,7 @@ enum CONNECTORS { NOTUSED = 777, ORR, ANDD };
 // Less than, equal to, greater than
 enum COMPTYPE { LT = 1111, EQ, GT };
 
-struct COORDINATE {
-  double x;
-  double y;
-};
+class ThreadPool;
 
 struct PARAMETERS_T {
   double LENGTH1; // Length in LICs 0, 7, 12
@@ -39,6 +39,24 @@ struct PARAMETERS_T {
   double AREA2;   // Maximum area in LIC 14
 };
 
+// Logical Connector Matrix. IMPORTANT! LCM[y][x] <-- y first then x.
+typedef std::array<std::array<CONNECTORS, 15>, 15> LCM_T;
+// Preliminary Unlocking Matrix. IMPORTANT! PUM[y][x] <-- y first then x.
+typedef std::array<std::array<bool, 15>, 15> PUM_T;
+
+// Everything besides the points that a launch decision depends on.
+struct CONFIG_T {
+  PARAMETERS_T PARAMETERS; // Struct holding the parameters for LICs.
+  LCM_T LCM;               // Logical Connector Matrix.
+  std::array<bool, 15> PUV; // Preliminary unlocking vector.
+};
+
+// Result of one launch decision.
+struct DECISION_T {
+  bool LAUNCH;
+  std::array<bool, 15> CMV; // Conditions Met Vector.
+};
+
 class Decide {
   // LIC0
   FRIEND_TEST(CMV, LIC0_POSITIVE);
@@ -47,6 +65,7 @@ class Decide {
   FRIEND_TEST(CMV, LIC1_POSITIVE);
   FRIEND_TEST(CMV, LIC1_NEGATIVE);
   FRIEND_TEST(CMV, LIC1_BOUNDRARY);
+  FRIEND_TEST(CMV, LIC1_COLLINEAR);
   // LIC2
   FRIEND_TEST(CMV, LIC2_POSITIVE);
   FRIEND_TEST(CMV, LIC2_NEGATIVE_BAD_ANGLE);
@@ -64,6 +83,8 @@ class Decide {
   FRIEND_TEST(CMV, LIC6_POSITIVE);
   FRIEND_TEST(CMV, LIC6_NEGATIVE);
   FRIEND_TEST(CMV, LIC6_BOUNDRARY);
+  FRIEND_TEST(CMV, LIC6_OUTSIDE_WINDOW);
+  FRIEND_TEST(CMV, LIC6_COINCIDENT);
   // LIC7
   FRIEND_TEST(CMV, LIC7_POSITIVE);
   FRIEND_TEST(CMV, LIC7_NEGATIVE_NUMPOINTS);
@@ -72,6 +93,7 @@ class Decide {
   FRIEND_TEST(CMV, LIC8_POSITIVE);
   FRIEND_TEST(CMV, LIC8_NEGATIVE);
   FRIEND_TEST(CMV, LIC8_BOUNDRARY);
+  FRIEND_TEST(CMV, LIC8_OBTUSE);
   // LIC9
   FRIEND_TEST(CMV, LIC9_POSITIVE);
   FRIEND_TEST(CMV, LIC9_NEGATIVE);
@@ -103,17 +125,41 @@ class Decide {
   FRIEND_TEST(LAUNCH, LAUNCH_NEGATIVE);
   FRIEND_TEST(LAUNCH, LAUNCH_NEGATIVE2);
 
+  FRIEND_TEST(INCREMENTAL, MATCHES_DECIDE);
+  FRIEND_TEST(INCREMENTAL, DISTANCE_AT_TOLERANCE);
+  FRIEND_TEST(PARALLEL, MATCHES_SERIAL);
+  FRIEND_TEST(PARALLEL, LAUNCH_POSITIVE);
+  FRIEND_TEST(VIEW, MATCHES_COPY);
+  FRIEND_TEST(ENGINE, MATCHES_DECIDE);
+  FRIEND_TEST(INSTRUMENT, COUNTS);
+
+  // Benchmarks of the individual steps, see bench/DecideBench.cpp.
+  friend class DecideBench;
+
 private:
   // Inputs
   const int NUMPOINTS; // Number of planar data points.
-  const std::vector<COORDINATE>
-      COORDINATES; // Array containing the coordinates of data points.
+  const POINTS_SOA OWNED_COORDINATES; // Copy of the coordinates, as separate
+                                      // x and y arrays. Empty if borrowed.
+  const POINTS_VIEW COORDINATES; // Coordinates of data points, either
+                                 // OWNED_COORDINATES or borrowed.
   const PARAMETERS_T PARAMETERS; // Struct holding the parameters for LICs.
   const std::array<std::array<CONNECTORS, 15>, 15>
       LCM; // Logical Connector Matrix. IMPORTANT! LCM[y][x] <-- y first then
            // x.
   const std::array<bool, 15> PUV; // Preliminary unlocking vector.
 
+  // Distances, x differences and quadrants of the points, shared by the LICs
+  // and debugprint().
+  mutable FrameCache CACHE;
+
+  // Scans of LICs 8, 9, 10, 13 and 14, compiled for the gaps of PARAMETERS if
+  // they are common ones.
+  const GAP_KERNELS_T KERNELS;
+
+  // Bounds of the angle test of LICs 2 and 9 for PARAMETERS.EPSILON.
+  const ANGLE_BOUNDS_T ANGLE_BOUNDS;
+
   // Outputs
   bool LAUNCH;
   std::array<bool, 15> CMV; // Conditions Met Vector.
@@ -134,6 +180,8 @@ private:
 
   // Step 2.1 from specification.
   void Calc_CMV();
+  // Step 2.1, with the LICs spread over the threads of POOL.
+  void Calc_CMV(ThreadPool &POOL);
 
   bool Lic0();
   bool Lic1();
@@ -160,14 +208,31 @@ private:
   // 2.4 from specification.
   void Calc_LAUNCH();
 
+  // Steps 2.2 - 2.4, then prints the answer to stdout.
+  void Calc_Decision();
+
 public:
   Decide(int NUMPOINTS, const std::vector<COORDINATE> &POINTS,
          const PARAMETERS_T &PARAMETERS,
          const std::array<std::array<CONNECTORS, 15>, 15> &LCM,
          const std::array<bool, 15> &PUV);
 
+  // Evaluates the points in place, without copying them. They must stay alive
+  // and unchanged for as long as the Decide object is used.
+  Decide(int NUMPOINTS, const POINTS_VIEW &POINTS,
+         const PARAMETERS_T &PARAMETERS,
+         const std::array<std::array<CONNECTORS, 15>, 15> &LCM,
+         const std::array<bool, 15> &PUV);
+
+  // COORDINATES may point into OWNED_COORDINATES, which a copy would not
+  // follow.
+  Decide(const Decide &) = delete;
+  Decide &operator=(const Decide &) = delete;
+
   // Call functions for 2.1 - 2.4 and print answer to stdout.
   void decide();
+  // Same as decide(), but evaluates the LICs in parallel on POOL.
+  void decide(ThreadPool &POOL);
 
   // Debug function that prints all member variables to stdout.
   void debugprint() const;
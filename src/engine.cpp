@@ -0,0 +1,207 @@
+#include "engine.h"
+#include "geometry.h"
+#include "kernels.h"
+#include <chrono>
+
+CompiledConfig::CompiledConfig(const CONFIG_T &CONFIG)
+    : CONFIG(CONFIG), launch(CONFIG.LCM, CONFIG.PUV) {
+  const PARAMETERS_T &P = CONFIG.PARAMETERS;
+  length1_far = greaterThanSquared(P.LENGTH1);
+  length2_near = lessThanSquared(P.LENGTH2);
+  dist_far = greaterThanSquared(P.DIST);
+  radius1_diameter2 = circleDiameter2(P.RADIUS1);
+  radius2_diameter2 = circleDiameter2(P.RADIUS2);
+  angle_bounds = angleBounds(P.EPSILON);
+  kernels = gapKernels(P);
+
+  const bool k = P.K_PTS >= 0;
+  const bool ab = P.A_PTS >= 0 && P.B_PTS >= 0;
+  const bool cd = P.C_PTS >= 0 && P.D_PTS >= 0;
+  const bool ef = P.E_PTS >= 0 && P.F_PTS >= 0;
+  const bool g = P.G_PTS >= 0;
+  span = {2,
+          3,
+          3,
+          3,
+          P.Q_PTS > 0 ? P.Q_PTS : 0,
+          2,
+          P.N_PTS >= 3 ? P.N_PTS : 0,
+          k ? P.K_PTS + 2 : 0,
+          ab ? P.A_PTS + P.B_PTS + 3 : 0,
+          cd ? P.C_PTS + P.D_PTS + 3 : 0,
+          ef ? P.E_PTS + P.F_PTS + 3 : 0,
+          g ? P.G_PTS + 2 : 0,
+          k ? P.K_PTS + 2 : 0,
+          ab ? P.A_PTS + P.B_PTS + 3 : 0,
+          ef ? P.E_PTS + P.F_PTS + 3 : 0};
+  min_points = {0, 0, 0, 0, 0, 0, 3, 3, 5, 5, 5, 3, 3, 5, 5};
+
+  // Single compares, then distances, areas, radii and angles, then the LICs
+  // that look at a whole window of points per start.
+  order = {5, 11, 0, 7, 12, 3, 10, 14, 1, 8, 13, 2, 9, 4, 6};
+}
+
+bool CompiledConfig::angleOutside(const COORDINATE &point1,
+                                  const COORDINATE &point2,
+                                  const COORDINATE &point3) const {
+  return angleOutsideBounds(point1, point2, point3, angle_bounds);
+}
+
+DecideEngine::DecideEngine(const CompiledConfig &CONFIG)
+    : CONFIG(CONFIG), computed(0), order(CONFIG.order), profile(nullptr),
+      launches(0) {
+  decision.LAUNCH = false;
+  decision.CMV.fill(false);
+  bits.fill(0);
+}
+
+void DecideEngine::reserve(int NUMPOINTS) { cache.reserve(NUMPOINTS, 0); }
+
+bool DecideEngine::lic(int LIC, int NUMPOINTS,
+                       const POINTS_VIEW &POINTS) const {
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  const POINTS_VIEW &C = POINTS;
+  const GAP_KERNELS_T &K = CONFIG.kernels;
+  const int windows = CONFIG.windows(LIC, NUMPOINTS);
+  if (windows == 0)
+    return false;
+
+  switch (LIC) {
+  case 0:
+    return anyPairAtLeast(C, NUMPOINTS, 1, CONFIG.length1_far);
+  case 1:
+    return firstRadiusAbove(C, NUMPOINTS, 1, 1, P.RADIUS1) >= 0;
+  case 2:
+    return firstAngleOutside(C, NUMPOINTS, 1, 1, CONFIG.angle_bounds) >= 0;
+  case 3:
+    return firstAreaAbove(C, NUMPOINTS, 1, 1, P.AREA1) >= 0;
+  case 4:
+    return firstQuadrantWindow(cache.quadrants(), NUMPOINTS, P.Q_PTS,
+                               P.QUADS) >= 0;
+  case 5:
+    return firstDecrease(C, NUMPOINTS, 1) >= 0;
+  case 6:
+    return anyWindowAtLeast(C, NUMPOINTS, P.N_PTS, CONFIG.dist_far);
+  case 7:
+    return K.pair_at_least(C, NUMPOINTS, P.K_PTS + 1, CONFIG.length1_far) >=
+           0;
+  case 8:
+    return K.radius_above(C, NUMPOINTS, P.A_PTS + 1, P.B_PTS + 1,
+                          P.RADIUS1) >= 0;
+  case 9:
+    return K.angle_outside(C, NUMPOINTS, P.C_PTS + 1, P.D_PTS + 1,
+                           CONFIG.angle_bounds) >= 0;
+  case 10:
+    return K.area_above(C, NUMPOINTS, P.E_PTS + 1, P.F_PTS + 1, P.AREA1) >=
+           0;
+  case 11:
+    return K.decrease(C, NUMPOINTS, P.G_PTS + 1) >= 0;
+  case 12:
+    return K.pair_at_most(C, NUMPOINTS, P.K_PTS + 1, CONFIG.length2_near) >=
+           0;
+  case 13:
+    return K.radius_within(C, NUMPOINTS, P.A_PTS + 1, P.B_PTS + 1,
+                           P.RADIUS2) >= 0;
+  case 14:
+    return K.area_below(C, NUMPOINTS, P.E_PTS + 1, P.F_PTS + 1, P.AREA2) >=
+           0;
+  }
+  return false;
+}
+
+bool DecideEngine::cmv(int LIC, int NUMPOINTS, const POINTS_VIEW &POINTS,
+                       uint16_t &KNOWN, uint16_t &VALUE) {
+  const uint16_t bit = 1 << LIC;
+  if (KNOWN & bit)
+    return VALUE & bit;
+
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  bool met;
+  if (LIC == 12) {
+    met = cmv(7, NUMPOINTS, POINTS, KNOWN, VALUE) &&
+          lic(12, NUMPOINTS, POINTS);
+  } else if (LIC == 13) {
+    met = cmv(8, NUMPOINTS, POINTS, KNOWN, VALUE) &&
+          lic(13, NUMPOINTS, POINTS);
+  } else if (LIC == 14) {
+    met = cmv(10, NUMPOINTS, POINTS, KNOWN, VALUE) &&
+          lic(14, NUMPOINTS, POINTS);
+  } else if (LIC == 4 && P.Q_PTS <= 0) {
+    met = 0 > P.QUADS; // an empty window covers no quadrants
+  } else {
+    met = lic(LIC, NUMPOINTS, POINTS);
+  }
+
+  decision.CMV[LIC] = met;
+  KNOWN |= bit;
+  if (met)
+    VALUE |= bit;
+  return met;
+}
+
+const DECISION_T &DecideEngine::evaluate(int NUMPOINTS,
+                                         const POINTS_VIEW &POINTS) {
+  uint16_t known = 0;
+  uint16_t value = 0;
+  cache.reset(NUMPOINTS, POINTS);
+  for (int l = 0; l < 15; ++l) {
+    cmv(l, NUMPOINTS, POINTS, known, value);
+  }
+  computed = known;
+
+  packCMV(decision.CMV, 0, bits);
+  decision.LAUNCH = CONFIG.launch.launch(bits) & 1;
+  return decision;
+}
+
+const DECISION_T &DecideEngine::evaluate(const std::vector<COORDINATE> &POINTS) {
+  return evaluate(POINTS.size(), POINTS_VIEW(POINTS.data()));
+}
+
+bool DecideEngine::launch(int NUMPOINTS, const POINTS_VIEW &POINTS) {
+  const uint16_t needed = CONFIG.launch.needed();
+  uint16_t known = 0;
+  uint16_t value = 0;
+  decision.CMV.fill(false);
+  cache.reset(NUMPOINTS, POINTS);
+
+  if (profile != nullptr && launches % REORDER_INTERVAL == 0)
+    order = profile->order(needed, CONFIG.order);
+  ++launches;
+
+  int decided = CONFIG.launch.partialLaunch(known, value);
+  for (int n = 0; n < 15 && decided < 0; ++n) {
+    const int l = order[n];
+    if (!(needed >> l & 1) || (known >> l & 1))
+      continue;
+
+    if (profile == nullptr) {
+      cmv(l, NUMPOINTS, POINTS, known, value);
+    } else {
+      typedef std::chrono::steady_clock clock;
+      const clock::time_point start = clock::now();
+      const bool met = cmv(l, NUMPOINTS, POINTS, known, value);
+      const std::chrono::duration<double, std::nano> elapsed =
+          clock::now() - start;
+      // Decisive if this entry on its own settles LAUNCH, whatever was
+      // computed before it.
+      const uint16_t bit = 1 << l;
+      profile->record(l, elapsed.count(),
+                      CONFIG.launch.partialLaunch(bit, met ? bit : 0) >= 0);
+    }
+    decided = CONFIG.launch.partialLaunch(known, value);
+  }
+  computed = known;
+  decision.LAUNCH = decided == 1;
+  return decision.LAUNCH;
+}
+
+void DecideEngine::useProfile(LicProfile *PROFILE) {
+  profile = PROFILE;
+  order = CONFIG.order;
+  launches = 0;
+}
+
+bool DecideEngine::launch(const std::vector<COORDINATE> &POINTS) {
+  return launch(POINTS.size(), POINTS_VIEW(POINTS.data()));
+}
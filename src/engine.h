@@ -0,0 +1,145 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include "decide.h"
+#include "geometry.h"
+#include "profile.h"
+#include "unlock.h"
+#include <algorithm>
+
+/**
+ * @brief A configuration (parameters, LCM and PUV) compiled once into the form
+ * the LIC tests use, for evaluating any number of frames with DecideEngine.
+ *
+ *  - Length thresholds are squared, so that distances need no sqrt.
+ *  - The angle test of LICs 2 and 9 becomes bounds on the dot and cross
+ *    products of the legs, so that it needs no sqrt or acos.
+ *  - The gap parameters are checked once: every LIC gets the number of points
+ *    its windows span, or none if it can never be met.
+ *  - The scans of LICs 7 to 14 are selected for the gap parameters, with
+ *    the gaps compiled in if they are common ones (see gapKernels()).
+ *  - The LCM and PUV are compiled into a BitslicedLaunch, which also knows
+ *    which CMV entries the launch decision depends on at all.
+ */
+class CompiledConfig {
+public:
+  const CONFIG_T CONFIG;
+
+  // Squared distances, see greaterThanSquared() and lessThanSquared().
+  double length1_far;  // LICs 0, 7, 12
+  double length2_near; // LIC 12
+  double dist_far;     // LIC 6
+
+  // Squared diameters of circles of RADIUS1 (LICs 1, 8) and RADIUS2 (LIC 13),
+  // see fitsInCircle().
+  double radius1_diameter2;
+  double radius2_diameter2;
+
+  // Bounds of an angle outside PI +- EPSILON, see angleBounds().
+  ANGLE_BOUNDS_T angle_bounds;
+
+  GAP_KERNELS_T kernels;
+
+  // Points spanned by one window of each LIC, 0 if the LIC is never met, and
+  // the least NUMPOINTS for which it can be met.
+  std::array<int, 15> span;
+  std::array<int, 15> min_points;
+
+  BitslicedLaunch launch;
+
+  // Order in which DecideEngine::launch() computes CMV entries, cheapest LIC
+  // first.
+  std::array<int, 15> order;
+
+  explicit CompiledConfig(const CONFIG_T &CONFIG);
+
+  // Angle test of LICs 2 and 9, the same as angleOutsidePi().
+  bool angleOutside(const COORDINATE &point1, const COORDINATE &point2,
+                    const COORDINATE &point3) const;
+
+  // Number of windows of a LIC in a track of NUMPOINTS points.
+  int windows(int LIC, int NUMPOINTS) const {
+    if (span[LIC] == 0 || NUMPOINTS < min_points[LIC])
+      return 0;
+    return std::max(NUMPOINTS - span[LIC] + 1, 0);
+  }
+};
+
+/**
+ * @brief Evaluates frame after frame against one CompiledConfig.
+ *
+ * Unlike Decide, which holds one frame for its whole life, an engine is built
+ * once and then given each frame's points with evaluate(). The points are
+ * read in place, and the decision is written to storage owned by the engine,
+ * so evaluate() and launch() do not allocate, except to grow the FrameCache
+ * for a frame longer than any before. After reserve() for the longest frame
+ * they do not allocate at all.
+ *
+ * Gives the same CMV and launch decision as Decide.
+ */
+class DecideEngine {
+private:
+  const CompiledConfig CONFIG;
+  DECISION_T decision;
+  uint16_t computed; // CMV entries of decision that were computed
+  CMV_BITS_T bits;
+
+  // Order used by launch(), refreshed from the profile if there is one.
+  std::array<int, 15> order;
+  LicProfile *profile;
+  uint64_t launches;
+
+  // Derived data of the current frame, kept from frame to frame so that it is
+  // only allocated when a frame is longer than all before. Only LIC 4 takes
+  // its quadrants from it: the distance and x difference scans read the points
+  // directly, as for one frame computing a pair again costs less than storing
+  // it and reading it back.
+  mutable FrameCache cache;
+
+  // Whether the frame meets a LIC. For LICs 12, 13 and 14 only their second
+  // condition; the first is the one of LICs 7, 8 and 10.
+  bool lic(int LIC, int NUMPOINTS, const POINTS_VIEW &POINTS) const;
+
+  // Computes CMV entry LIC unless it is in KNOWN already, and records it in
+  // decision.CMV, KNOWN and VALUE.
+  bool cmv(int LIC, int NUMPOINTS, const POINTS_VIEW &POINTS, uint16_t &KNOWN,
+           uint16_t &VALUE);
+
+public:
+  explicit DecideEngine(const CompiledConfig &CONFIG);
+
+  // Allocates what frames of up to NUMPOINTS points need.
+  void reserve(int NUMPOINTS);
+
+  // CMV and launch decision of a frame. The reference stays valid until the
+  // next call.
+  const DECISION_T &evaluate(int NUMPOINTS, const POINTS_VIEW &POINTS);
+  const DECISION_T &evaluate(const std::vector<COORDINATE> &POINTS);
+
+  /**
+   * @brief Launch decision of a frame, computing only the CMV entries it
+   * needs. Entries that the LCM and PUV never look at are skipped, and the
+   * remaining ones are computed in CONFIG.order, or the order of the profile
+   * (see useProfile()), until the decision no longer depends on the others.
+   * Entries that were not computed are false in the CMV of the last decision.
+   */
+  bool launch(int NUMPOINTS, const POINTS_VIEW &POINTS);
+  bool launch(const std::vector<COORDINATE> &POINTS);
+
+  // Decision of the last evaluate() or launch(), and the CMV entries it
+  // computed, bit i for entry i: all of them after evaluate().
+  const DECISION_T &lastDecision() const { return decision; }
+  uint16_t computedEntries() const { return computed; }
+
+  /**
+   * @brief Makes launch() record the cost and decisiveness of every LIC it
+   * computes in PROFILE, and take its order from PROFILE, refreshed every
+   * REORDER_INTERVAL calls. PROFILE must outlive its use by the engine;
+   * nullptr goes back to CONFIG.order.
+   */
+  void useProfile(LicProfile *PROFILE);
+
+  static const int REORDER_INTERVAL = 64;
+};
+
+#endif
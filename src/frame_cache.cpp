@@ -0,0 +1,248 @@
+#include "frame_cache.h"
+#include "compare.h"
+#include "kernels.h"
+#include <algorithm>
+
+// Pairs computed and tested between two checks for an early exit.
+static const int BLOCK = 16;
+
+// Threshold tests of the cached scans, on one value and, with SSE2, as a mask
+// on two.
+struct AtLeast {
+  double limit;
+  // "not less than" so that NaN counts as farther, like DOUBLECOMPARE
+  bool operator()(double value) const { return !(value < limit); }
+#if defined(__SSE2__)
+  __m128d operator()(__m128d value) const {
+    return _mm_cmpnlt_pd(value, _mm_set1_pd(limit));
+  }
+#endif
+};
+
+struct AtMost {
+  double limit;
+  bool operator()(double value) const { return value <= limit; }
+#if defined(__SSE2__)
+  __m128d operator()(__m128d value) const {
+    return _mm_cmple_pd(value, _mm_set1_pd(limit));
+  }
+#endif
+};
+
+struct Negative {
+  bool operator()(double value) const { return lessWithTolerance(value, 0); }
+#if defined(__SSE2__)
+  __m128d operator()(__m128d value) const {
+    return lessMask(value, _mm_setzero_pd());
+  }
+#endif
+};
+
+// For filling in all values.
+struct Never {
+  bool operator()(double) const { return false; }
+#if defined(__SSE2__)
+  __m128d operator()(__m128d) const { return _mm_setzero_pd(); }
+#endif
+};
+
+// Index of the first of VALUES[BEGIN, END) that passes TEST, or -1.
+template <typename TEST>
+static int firstIn(const double *VALUES, int BEGIN, int END, TEST test) {
+  int i = BEGIN;
+#if defined(__SSE2__)
+  // The whole range without branches first, then the exact position.
+  __m128d hit = _mm_setzero_pd();
+  for (; i + 2 <= END; i += 2)
+    hit = _mm_or_pd(hit, test(_mm_loadu_pd(VALUES + i)));
+  if (_mm_movemask_pd(hit) == 0)
+    BEGIN = i;
+#endif
+  for (i = BEGIN; i < END; ++i) {
+    if (test(VALUES[i]))
+      return i;
+  }
+  return -1;
+}
+
+// Makes room for END values in VALUES. Storage only grows, geometrically, so
+// that it is neither cleared for every frame nor allocated in full for a scan
+// that stops early, and not beyond reserve()d storage that is large enough.
+static void reserveValues(std::vector<double> &VALUES, int END) {
+  if ((int)VALUES.size() >= END)
+    return;
+  size_t size = std::max((size_t)std::max(END, 1024), 2 * VALUES.size());
+  if (VALUES.capacity() >= (size_t)END)
+    size = std::min(size, VALUES.capacity());
+  VALUES.resize(size);
+}
+
+FrameCache::FrameCache()
+    : NUMPOINTS(0), gaps_used(0), quadrants_valid(false) {}
+
+FrameCache::FrameCache(int NUMPOINTS, const POINTS_VIEW &POINTS)
+    : NUMPOINTS(NUMPOINTS), POINTS(POINTS), gaps_used(0),
+      quadrants_valid(false) {}
+
+void FrameCache::reset(int NUMPOINTS, const POINTS_VIEW &POINTS) {
+  this->NUMPOINTS = NUMPOINTS;
+  this->POINTS = POINTS;
+  gaps_used = 0;
+  quadrants_valid = false;
+}
+
+void FrameCache::reserve(int NUMPOINTS, int GAPS) {
+  const size_t values = std::max(NUMPOINTS, 0);
+  if ((int)gaps.size() < GAPS)
+    gaps.resize(GAPS);
+  for (Gap &slot : gaps) {
+    slot.dx.reserve(values);
+    slot.d2.reserve(values);
+  }
+  quadrant_codes.reserve(values);
+}
+
+int FrameCache::pairs(int gap) const {
+  return gap < 0 ? 0 : std::max(NUMPOINTS - gap, 0);
+}
+
+FrameCache::Gap &FrameCache::slot(int gap) {
+  for (int n = 0; n < gaps_used; ++n) {
+    if (gaps[n].gap == gap)
+      return gaps[n];
+  }
+  if (gaps_used == (int)gaps.size())
+    gaps.push_back(Gap());
+
+  Gap &slot = gaps[gaps_used++];
+  slot.gap = gap;
+  slot.dx_end = slot.dy_end = slot.d2_end = 0;
+  return slot;
+}
+
+template <typename TEST>
+int FrameCache::extend(const double *COORDINATES, Gap &SLOT,
+                       std::vector<double> &VALUES, int &END, TEST test) {
+  const double *c = COORDINATES;
+  const int s = POINTS.stride;
+  const int gap = SLOT.gap;
+  const int n = pairs(gap);
+  while (END < n) {
+    const int begin = END;
+    const int end = std::min(begin + BLOCK, n);
+    reserveValues(VALUES, end);
+    double *values = VALUES.data();
+    int i = begin;
+    bool hit = false;
+#if defined(__SSE2__)
+    __m128d mask = _mm_setzero_pd();
+    for (; s == 1 && i + 2 <= end; i += 2) {
+      const __m128d d =
+          _mm_sub_pd(_mm_loadu_pd(c + i + gap), _mm_loadu_pd(c + i));
+      _mm_storeu_pd(values + i, d);
+      mask = _mm_or_pd(mask, test(d));
+    }
+    hit = _mm_movemask_pd(mask) != 0;
+#endif
+    for (; i < end; ++i) {
+      values[i] = c[(i + gap) * s] - c[i * s];
+      hit |= test(values[i]);
+    }
+    END = end;
+    if (hit)
+      return firstIn(values, begin, end, test);
+  }
+  return -1;
+}
+
+template <typename TEST>
+int FrameCache::extendDistance2(Gap &SLOT, TEST test) {
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const int s = POINTS.stride;
+  const int gap = SLOT.gap;
+  const int n = pairs(gap);
+  while (SLOT.d2_end < n) {
+    const int begin = SLOT.d2_end;
+    const int end = std::min(begin + BLOCK, n);
+    reserveValues(SLOT.d2, end);
+    double *d2 = SLOT.d2.data();
+    int i = begin;
+    bool hit = false;
+#if defined(__SSE2__)
+    __m128d mask = _mm_setzero_pd();
+    for (; s == 1 && i + 2 <= end; i += 2) {
+      const __m128d dx =
+          _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+      const __m128d dy =
+          _mm_sub_pd(_mm_loadu_pd(y + i + gap), _mm_loadu_pd(y + i));
+      const __m128d d = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      _mm_storeu_pd(d2 + i, d);
+      mask = _mm_or_pd(mask, test(d));
+    }
+    hit = _mm_movemask_pd(mask) != 0;
+#endif
+    for (; i < end; ++i) {
+      const double dx = x[(i + gap) * s] - x[i * s];
+      const double dy = y[(i + gap) * s] - y[i * s];
+      d2[i] = dx * dx + dy * dy;
+      hit |= test(d2[i]);
+    }
+    SLOT.d2_end = end;
+    if (hit)
+      return firstIn(d2, begin, end, test);
+  }
+  return -1;
+}
+
+const double *FrameCache::dx(int gap) {
+  Gap &s = slot(gap);
+  extend(POINTS.x, s, s.dx, s.dx_end, Never());
+  return s.dx.data();
+}
+
+const double *FrameCache::dy(int gap) {
+  Gap &s = slot(gap);
+  extend(POINTS.y, s, s.dy, s.dy_end, Never());
+  return s.dy.data();
+}
+
+const double *FrameCache::distance2(int gap) {
+  Gap &s = slot(gap);
+  extendDistance2(s, Never());
+  return s.d2.data();
+}
+
+const uint8_t *FrameCache::quadrants() {
+  if (!quadrants_valid) {
+    if ((int)quadrant_codes.size() < NUMPOINTS)
+      quadrant_codes.resize(NUMPOINTS);
+    quadrantCodes(POINTS, NUMPOINTS, quadrant_codes.data());
+    quadrants_valid = true;
+  }
+  return quadrant_codes.data();
+}
+
+// Scans of the values stored already, then of those computed on the way.
+int FrameCache::firstDistanceAtLeast(int gap, double limit) {
+  Gap &s = slot(gap);
+  const AtLeast test = {limit};
+  const int first = firstIn(s.d2.data(), 0, s.d2_end, test);
+  return first >= 0 ? first : extendDistance2(s, test);
+}
+
+int FrameCache::firstDistanceAtMost(int gap, double limit) {
+  if (limit < 0)
+    return -1;
+  Gap &s = slot(gap);
+  const AtMost test = {limit};
+  const int first = firstIn(s.d2.data(), 0, s.d2_end, test);
+  return first >= 0 ? first : extendDistance2(s, test);
+}
+
+int FrameCache::firstDecrease(int gap) {
+  Gap &s = slot(gap);
+  const Negative test = Negative();
+  const int first = firstIn(s.dx.data(), 0, s.dx_end, test);
+  return first >= 0 ? first : extend(POINTS.x, s, s.dx, s.dx_end, test);
+}
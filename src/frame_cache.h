@@ -0,0 +1,101 @@
+#ifndef FRAME_CACHE_H
+#define FRAME_CACHE_H
+
+#include "points.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Data derived from the points of one frame, computed on first use and
+ * then shared by every LIC that needs it.
+ *
+ * For each gap the LICs ask for, the cache holds the differences dx, dy and
+ * the squared distance between points i and i + gap, and for the whole frame
+ * the quadrant() of every point. LICs 7 and 12, for instance, then compute
+ * the distances of their gap once between them, and LICs 5 and 11 the dx of
+ * theirs if it is the same.
+ *
+ * The arrays are filled as far as a scan has got, testing the values on the
+ * way, so a scan that stops early computes little more than it reads, and a
+ * later scan of the same values only reads them.
+ *
+ * reset() starts the next frame and keeps the storage, so that a cache used
+ * frame after frame only allocates for a gap or length it has not seen
+ * before, and not at all after a reserve() for the longest frame. Not thread
+ * safe.
+ */
+class FrameCache {
+private:
+  // Derived data of one gap. Entries before *_end are valid.
+  struct Gap {
+    int gap;
+    int dx_end;
+    int dy_end;
+    int d2_end;
+    std::vector<double> dx;
+    std::vector<double> dy;
+    std::vector<double> d2;
+  };
+
+  int NUMPOINTS;
+  POINTS_VIEW POINTS;
+
+  // Slots of the gaps used by this frame come first; the others only keep
+  // their storage for later frames.
+  std::vector<Gap> gaps;
+  int gaps_used;
+
+  std::vector<uint8_t> quadrant_codes;
+  bool quadrants_valid;
+
+  // The slot of a gap, a fresh one if this frame has not used the gap yet.
+  Gap &slot(int gap);
+
+  // Computes, stores and tests the values of SLOT after those computed
+  // already, a block at a time, and returns the first that passes TEST, or -1.
+  // Stops after the block of that value.
+  template <typename TEST>
+  int extend(const double *COORDINATES, Gap &SLOT, std::vector<double> &VALUES,
+             int &END, TEST test);
+  template <typename TEST> int extendDistance2(Gap &SLOT, TEST test);
+
+public:
+  FrameCache();
+  FrameCache(int NUMPOINTS, const POINTS_VIEW &POINTS);
+
+  // Drops the derived data and starts on the given frame. The points must
+  // stay alive and unchanged until the next reset().
+  void reset(int NUMPOINTS, const POINTS_VIEW &POINTS);
+
+  // Reserves storage for the quadrants and the dx and squared distances of
+  // GAPS gaps of frames of up to NUMPOINTS points, so that a frame that uses
+  // no more gaps does not allocate. No LIC reads dy, so it is left to grow on
+  // first use. The storage is only touched once a scan gets to it.
+  void reserve(int NUMPOINTS, int GAPS);
+
+  int size() const { return NUMPOINTS; }
+  const POINTS_VIEW &points() const { return POINTS; }
+
+  // Number of pairs (i, i + gap) in the frame, none for a negative gap.
+  int pairs(int gap) const;
+
+  // x[i + gap] - x[i], y[i + gap] - y[i] and dx^2 + dy^2 for every pair. The
+  // arrays hold pairs(gap) values and stay valid until the next call.
+  const double *dx(int gap);
+  const double *dy(int gap);
+  const double *distance2(int gap);
+
+  // quadrant() of every point.
+  const uint8_t *quadrants();
+
+  // The first pair whose squared distance is not less (firstDistanceAtLeast)
+  // or not greater (firstDistanceAtMost) than limit, or -1. Same as
+  // firstPairAtLeast() and firstPairAtMost().
+  int firstDistanceAtLeast(int gap, double limit);
+  int firstDistanceAtMost(int gap, double limit);
+
+  // The first pair whose dx is less than 0, or -1. Same as firstDecrease().
+  int firstDecrease(int gap);
+};
+
+#endif
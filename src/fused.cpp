@@ -0,0 +1,202 @@
+#include "fused.h"
+#include "geometry.h"
+#include "kernels.h"
+#include <algorithm>
+
+namespace {
+
+// Number of windows of a gap LIC, or 0 if it is not met for NUMPOINTS points.
+int windowCount(int NUMPOINTS, int minimum, int span) {
+  if (NUMPOINTS < minimum || span < 1)
+    return 0;
+  return std::max(NUMPOINTS - span + 1, 0);
+}
+
+} // namespace
+
+std::array<bool, 15> fusedCMV(int NUMPOINTS,
+                              const std::vector<COORDINATE> &POINTS,
+                              const PARAMETERS_T &PARAMETERS) {
+  const PARAMETERS_T &P = PARAMETERS;
+  const COORDINATE *c = POINTS.data();
+
+  std::array<bool, 15> CMV;
+  CMV.fill(false);
+  // Second conditions of LICs 12, 13 and 14
+  bool lic12_length2 = false;
+  bool lic13_radius2 = false;
+  bool lic14_area2 = false;
+
+  // Number of windows (by their first point) each LIC looks at.
+  std::array<int, 15> windows;
+  windows[0] = windows[5] = windowCount(NUMPOINTS, 0, 2);
+  windows[1] = windows[2] = windows[3] = windowCount(NUMPOINTS, 0, 3);
+  windows[4] = P.Q_PTS > 0 ? windowCount(NUMPOINTS, 0, P.Q_PTS) : 0;
+  windows[6] = P.N_PTS >= 3 ? windowCount(NUMPOINTS, 3, P.N_PTS) : 0;
+  windows[7] = windows[12] =
+      P.K_PTS >= 0 ? windowCount(NUMPOINTS, 3, P.K_PTS + 2) : 0;
+  windows[8] = windows[13] = P.A_PTS >= 0 && P.B_PTS >= 0
+                                 ? windowCount(NUMPOINTS, 5, P.A_PTS + P.B_PTS + 3)
+                                 : 0;
+  windows[9] = P.C_PTS >= 0 && P.D_PTS >= 0
+                   ? windowCount(NUMPOINTS, 5, P.C_PTS + P.D_PTS + 3)
+                   : 0;
+  windows[10] = windows[14] =
+      P.E_PTS >= 0 && P.F_PTS >= 0
+          ? windowCount(NUMPOINTS, 5, P.E_PTS + P.F_PTS + 3)
+          : 0;
+  windows[11] = P.G_PTS >= 0 ? windowCount(NUMPOINTS, 3, P.G_PTS + 2) : 0;
+
+  // An empty LIC 4 window covers no quadrants.
+  if (P.Q_PTS <= 0 && NUMPOINTS >= P.Q_PTS)
+    CMV[4] = 0 > P.QUADS;
+
+  // Squared distances for LICs 0, 7 and 12
+  const double length1_gt = greaterThanSquared(P.LENGTH1);
+  const double length2_lt = lessThanSquared(P.LENGTH2);
+  // Angle bounds for LICs 2 and 9, circles for LICs 1, 8 and 13
+  const ANGLE_BOUNDS_T angle = angleBounds(P.EPSILON);
+  const double radius1_d2 = circleDiameter2(P.RADIUS1);
+  const double radius2_d2 = circleDiameter2(P.RADIUS2);
+  // Squared distance for LIC 6, twice the areas for LICs 3, 10 and 14
+  const double dist_gt = greaterThanSquared(P.DIST);
+  const double area1_gt = greaterThanDoubled(P.AREA1);
+  const double area2_lt = lessThanDoubled(P.AREA2);
+
+  // Quadrants of the current LIC 4 window
+  QuadrantWindow quadrants;
+  for (int j = 0; j < std::min(P.Q_PTS, NUMPOINTS); ++j) {
+    quadrants.add(quadrant(c[j]));
+  }
+
+  // Quantities shared by two LICs, for the window starts of one tile
+  double k_distance[FUSED_TILE];
+
+  const int longest = *std::max_element(windows.begin(), windows.end());
+  for (int t0 = 0; t0 < longest; t0 += FUSED_TILE) {
+    const int t1 = t0 + FUSED_TILE;
+    // LIC i is settled once it is true or has no windows left in [t0, ...).
+    std::array<bool, 15> open;
+    bool any_open = false;
+    for (int l = 0; l < 15; ++l) {
+      open[l] = !CMV[l] && t0 < windows[l];
+      any_open = any_open || open[l];
+    }
+    if (!any_open)
+      break;
+
+    // Consecutive pairs
+    if (open[0] || open[5]) {
+      const int end = std::min(t1, windows[0]);
+      for (int i = t0; i < end && !(CMV[0] && CMV[5]); ++i) {
+        if (!(squaredDistance(c[i], c[i + 1]) < length1_gt))
+          CMV[0] = true;
+        if (lessWithTolerance(c[i + 1].x - c[i].x, 0))
+          CMV[5] = true;
+      }
+    }
+
+    // Consecutive triples
+    if (open[1] || open[2] || open[3]) {
+      const int end = std::min(t1, windows[1]);
+      for (int i = t0; i < end && !(CMV[1] && CMV[2] && CMV[3]); ++i) {
+        if (!CMV[1] && !fitsInCircle(c[i], c[i + 1], c[i + 2], radius1_d2))
+          CMV[1] = true;
+        if (!CMV[2] && angleOutsideBounds(c[i], c[i + 1], c[i + 2], angle))
+          CMV[2] = true;
+        if (!CMV[3] && twiceAreaAtLeast(c[i], c[i + 1], c[i + 2], area1_gt))
+          CMV[3] = true;
+      }
+    }
+
+    // Q_PTS window, slid one point at a time
+    if (open[4]) {
+      const int end = std::min(t1, windows[4]);
+      for (int i = t0; i < end; ++i) {
+        if (quadrants.occupied > P.QUADS) {
+          CMV[4] = true;
+          break;
+        }
+        if (i + 1 < windows[4]) {
+          quadrants.remove(quadrant(c[i]));
+          quadrants.add(quadrant(c[i + P.Q_PTS]));
+        }
+      }
+    }
+
+    // N_PTS window
+    if (open[6]) {
+      const int end = std::min(t1, windows[6]);
+      for (int i = t0; i < end && !CMV[6]; ++i) {
+        CMV[6] = lic6Window(c + i, P.N_PTS, dist_gt);
+      }
+    }
+
+    // Pairs separated by K_PTS points, shared by LICs 7 and 12
+    if (open[7] || open[12]) {
+      const int end = std::min(t1, windows[7]);
+      const int gap = P.K_PTS + 1;
+      for (int i = t0; i < end; ++i) {
+        k_distance[i - t0] = squaredDistance(c[i], c[i + gap]);
+      }
+      for (int i = t0; i < end && !CMV[7]; ++i) {
+        CMV[7] = !(k_distance[i - t0] < length1_gt);
+      }
+      for (int i = t0; i < end && !lic12_length2; ++i) {
+        lic12_length2 = k_distance[i - t0] <= length2_lt;
+      }
+    }
+
+    // Triples separated by A_PTS and B_PTS points, shared by LICs 8 and 13
+    if (open[8] || open[13]) {
+      const int end = std::min(t1, windows[8]);
+      for (int i = t0; i < end && !(CMV[8] && lic13_radius2); ++i) {
+        const COORDINATE &p1 = c[i];
+        const COORDINATE &p2 = c[i + P.A_PTS + 1];
+        const COORDINATE &p3 = c[i + P.A_PTS + P.B_PTS + 2];
+        if (!CMV[8] && !fitsInCircle(p1, p2, p3, radius1_d2))
+          CMV[8] = true;
+        if (!lic13_radius2 && fitsInCircle(p1, p2, p3, radius2_d2))
+          lic13_radius2 = true;
+      }
+    }
+
+    // Triples separated by C_PTS and D_PTS points
+    if (open[9]) {
+      const int end = std::min(t1, windows[9]);
+      for (int i = t0; i < end && !CMV[9]; ++i) {
+        CMV[9] = angleOutsideBounds(c[i], c[i + P.C_PTS + 1],
+                                    c[i + P.C_PTS + P.D_PTS + 2], angle);
+      }
+    }
+
+    // Triples separated by E_PTS and F_PTS points, shared by LICs 10 and 14
+    if (open[10] || open[14]) {
+      const int end = std::min(t1, windows[10]);
+      for (int i = t0; i < end && !(CMV[10] && lic14_area2); ++i) {
+        const COORDINATE &p1 = c[i];
+        const COORDINATE &p2 = c[i + P.E_PTS + 1];
+        const COORDINATE &p3 = c[i + P.E_PTS + P.F_PTS + 2];
+        if (!CMV[10] && twiceAreaAtLeast(p1, p2, p3, area1_gt))
+          CMV[10] = true;
+        if (!lic14_area2 && twiceAreaAtMost(p1, p2, p3, area2_lt))
+          lic14_area2 = true;
+      }
+    }
+
+    // Pairs separated by G_PTS points
+    if (open[11]) {
+      const int end = std::min(t1, windows[11]);
+      for (int i = t0; i < end && !CMV[11]; ++i) {
+        CMV[11] = lessWithTolerance(c[i + P.G_PTS + 1].x - c[i].x, 0);
+      }
+    }
+
+    // The two-part LICs are settled once both parts have been seen.
+    CMV[12] = CMV[7] && lic12_length2;
+    CMV[13] = CMV[8] && lic13_radius2;
+    CMV[14] = CMV[10] && lic14_area2;
+  }
+
+  return CMV;
+}
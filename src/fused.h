@@ -0,0 +1,26 @@
+#ifndef FUSED_H
+#define FUSED_H
+
+#include "decide.h"
+
+/**
+ * @brief Computes the whole CMV in a single pass over the points.
+ *
+ * Calc_CMV() runs fifteen separate loops, several of which compute the same
+ * quantity: LICs 7 and 12 the same K_PTS distances, LICs 8 and 13 the same
+ * circumradii, LICs 10 and 14 the same areas. This evaluator walks the points
+ * once, in tiles of FUSED_TILE window starts that stay in cache. Within a tile
+ * each shared quantity is computed once per index, and handed to every LIC
+ * that is still undecided. A LIC is settled as soon as it is known to be true,
+ * or when its windows run out, and the pass stops once all of them are.
+ *
+ * Gives the same CMV as Decide::Calc_CMV().
+ */
+std::array<bool, 15> fusedCMV(int NUMPOINTS,
+                              const std::vector<COORDINATE> &POINTS,
+                              const PARAMETERS_T &PARAMETERS);
+
+// Number of window starts handled per tile by fusedCMV().
+const int FUSED_TILE = 256;
+
+#endif
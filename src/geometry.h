@@ -0,0 +1,331 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include "compare.h"
+#include "decide.h"
+#include "predicates.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Per-window tests shared by every LIC implementation. Decide::LicN() loops
+// over these, and the other evaluators call the very same functions so that
+// they always agree with Decide.
+
+/**
+ * @brief Compares two doubles, treating values closer than COMPARE_EPSILON as
+ * equal. Threshold tests in loops use the branch-free forms in compare.h.
+ */
+inline COMPTYPE compareDoubles(double a, double b) {
+  if (std::fabs(a - b) < COMPARE_EPSILON)
+    return EQ;
+  if (a < b)
+    return LT;
+  return GT;
+}
+
+// Euclidean distance between two points (LICs 0, 7, 12).
+inline double pointDistance(const COORDINATE &a, const COORDINATE &b) {
+  return std::sqrt(std::pow(b.x - a.x, 2) + std::pow(b.y - a.y, 2));
+}
+
+// Squared distance between two points, computed as FrameCache::distance2()
+// computes it, for comparing with greaterThanSquared() and lessThanSquared().
+inline double squaredDistance(const COORDINATE &a, const COORDINATE &b) {
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  return dx * dx + dy * dy;
+}
+
+// Area of the triangle spanned by three points (LICs 3, 10, 14).
+// Formula from:
+// https://www.cuemath.com/geometry/area-of-triangle-in-coordinate-geometry/
+inline double triangleArea(const COORDINATE &c1, const COORDINATE &c2,
+                           const COORDINATE &c3) {
+  return 0.5 * std::fabs(c1.x * (c2.y - c3.y) + c2.x * (c3.y - c1.y) +
+                         c3.x * (c1.y - c2.y));
+}
+
+// Relative error bound of the filters below. A floating point value farther
+// than FILTER_ERROR times the magnitude of its terms from the threshold has
+// the sign of the exact one; this is twice the bound that Shewchuk gives for
+// orient2d, (3 + 16u) u for the unit roundoff u.
+const double FILTER_ERROR = 8 * DBL_EPSILON;
+
+// Whether the floating point DIFFERENCE has a certain sign, given the BOUND on
+// its rounding error. So does a NaN one, and one whose terms overflowed, as
+// the exact arithmetic could not do better on them.
+inline bool filterCertain(double DIFFERENCE, double BOUND) {
+  return !(std::fabs(DIFFERENCE) <= BOUND && BOUND < INFINITY);
+}
+
+/**
+ * @brief A number with the sign of |(p2 - p1) x (p3 - p1)| - LIMIT, twice the
+ * area of the triangle against LIMIT (LICs 3, 10, 14), exact in the
+ * coordinates. The floating point difference where the filter certifies its
+ * sign, otherwise exactTwiceAreaSign(). NaN or infinite, as the floating
+ * point difference, if a coordinate is.
+ */
+inline double twiceAreaSign(const COORDINATE &p1, const COORDINATE &p2,
+                            const COORDINATE &p3, double LIMIT) {
+  const double left = (p2.x - p1.x) * (p3.y - p1.y);
+  const double right = (p2.y - p1.y) * (p3.x - p1.x);
+  const double difference = std::fabs(left - right) - LIMIT;
+  const double bound = FILTER_ERROR * (std::fabs(left) + std::fabs(right));
+  if (filterCertain(difference, bound))
+    return difference;
+  return exactTwiceAreaSign(p1, p2, p3, LIMIT);
+}
+
+// Whether twice the area is not less (twiceAreaAtLeast) or not greater
+// (twiceAreaAtMost) than LIMIT. An area that compares GT to AREA in
+// DOUBLECOMPARE is at least 2 * (AREA + COMPARE_EPSILON), one that compares LT
+// at most 2 * (AREA - COMPARE_EPSILON), see greaterThanDoubled(). NaN counts
+// as at least LIMIT, like a NaN distance.
+inline bool twiceAreaAtLeast(const COORDINATE &p1, const COORDINATE &p2,
+                             const COORDINATE &p3, double LIMIT) {
+  return !(twiceAreaSign(p1, p2, p3, LIMIT) < 0);
+}
+
+inline bool twiceAreaAtMost(const COORDINATE &p1, const COORDINATE &p2,
+                            const COORDINATE &p3, double LIMIT) {
+  return twiceAreaSign(p1, p2, p3, LIMIT) <= 0;
+}
+
+/**
+ * @brief A number with the sign of cross^2 - LIMIT * |last - first|^2, where
+ * cross = (last - first) x (point - first): the squared distance of point from
+ * the line through first and last against LIMIT, multiplied out (LIC 6).
+ * Filtered like twiceAreaSign(), with exactLineDistanceSign() behind it.
+ */
+inline double lineDistanceSign(const COORDINATE &first, const COORDINATE &last,
+                               const COORDINATE &point, double LIMIT) {
+  const double dx = last.x - first.x, dy = last.y - first.y;
+  const double qx = point.x - first.x, qy = point.y - first.y;
+  const double left = dx * qy, right = qx * dy;
+  const double cross = left - right;
+  const double line_limit = LIMIT * (dx * dx + dy * dy);
+  const double difference = cross * cross - line_limit;
+  const double terms = std::fabs(left) + std::fabs(right);
+  const double bound = FILTER_ERROR * (terms * terms + std::fabs(line_limit));
+  if (filterCertain(difference, bound))
+    return difference;
+  return exactLineDistanceSign(first, last, point, LIMIT);
+}
+
+// A number with the sign of |point - first|^2 - LIMIT, filtered in the same
+// way, for windows whose first and last point coincide (LIC 6).
+inline double distanceSign(const COORDINATE &first, const COORDINATE &point,
+                           double LIMIT) {
+  const double qx = point.x - first.x, qy = point.y - first.y;
+  const double distance2 = qx * qx + qy * qy;
+  const double difference = distance2 - LIMIT;
+  if (filterCertain(difference, FILTER_ERROR * distance2))
+    return difference;
+  return exactDistanceSign(first, point, LIMIT);
+}
+
+/**
+ * @brief Radius of the smallest circle that contains three points (LICs 1, 8,
+ * 13). If the triangle they span has no acute angle, which includes collinear
+ * and coincident points, that circle has the longest side as its diameter.
+ * Otherwise it is the circumcircle, of diameter a * b * c / |cross|, where
+ * cross is twice the signed area.
+ *
+ * https://mathworld.wolfram.com/Circumradius.html
+ */
+inline double enclosingRadius(const COORDINATE &p1, const COORDINATE &p2,
+                              const COORDINATE &p3) {
+  const double ux = p2.x - p1.x, uy = p2.y - p1.y;
+  const double vx = p3.x - p1.x, vy = p3.y - p1.y;
+  const double wx = p3.x - p2.x, wy = p3.y - p2.y;
+  const double c2 = ux * ux + uy * uy;
+  const double b2 = vx * vx + vy * vy;
+  const double a2 = wx * wx + wy * wy;
+  const double longest2 = std::max(std::max(a2, b2), c2);
+  if (2 * longest2 >= a2 + b2 + c2)
+    return 0.5 * std::sqrt(longest2);
+  const double cross = ux * vy - uy * vx;
+  return std::sqrt(a2 * b2 * c2) / (2 * std::fabs(cross));
+}
+
+/**
+ * @brief Squared diameter of the circles tested by fitsInCircle() for RADIUS:
+ * (2 * (RADIUS + COMPARE_EPSILON))^2, or -1, which nothing is less than, if
+ * that radius is not positive.
+ */
+inline double circleDiameter2(double RADIUS) {
+  const double radius = RADIUS + COMPARE_EPSILON;
+  return radius > 0 ? 4 * radius * radius : -1;
+}
+
+/**
+ * @brief Whether three points fit in a circle of radius RADIUS, i.e. their
+ * enclosingRadius() does not compare GT to RADIUS, given DIAMETER2 =
+ * circleDiameter2(RADIUS).
+ *
+ * Compares the squares of both diameters of enclosingRadius() against
+ * DIAMETER2, multiplied out, so that it needs no sqrt or division, and
+ * collinear points take the longest side without a special case. The terms
+ * combine with bitwise operators so that loops over it can be vectorized.
+ * An acute triangle's circumdiameter is at most 2/sqrt(3) times its longest
+ * side, so one with 4 longest2 < 3 DIAMETER2 fits without the products, which
+ * underflow to 0 for tiny triangles.
+ */
+inline bool fitsInCircle(const COORDINATE &p1, const COORDINATE &p2,
+                         const COORDINATE &p3, double DIAMETER2) {
+  const double ux = p2.x - p1.x, uy = p2.y - p1.y;
+  const double vx = p3.x - p1.x, vy = p3.y - p1.y;
+  const double wx = p3.x - p2.x, wy = p3.y - p2.y;
+  const double c2 = ux * ux + uy * uy;
+  const double b2 = vx * vx + vy * vy;
+  const double a2 = wx * wx + wy * wy;
+  const double longest2 = std::max(std::max(a2, b2), c2);
+  const double cross = ux * vy - uy * vx;
+  const bool not_acute = 2 * longest2 >= a2 + b2 + c2;
+  const bool small = 4 * longest2 < 3 * DIAMETER2;
+  const bool circumcircle = a2 * b2 * c2 < DIAMETER2 * cross * cross;
+  return (longest2 < DIAMETER2) & (not_acute | small | circumcircle);
+}
+
+/// @brief Validates that an angle can be made with the three points provided
+/// @return returns True if neither point1 nor point3 coincides with the vertex
+inline bool validAngle(const COORDINATE &point1, const COORDINATE &point2,
+                       const COORDINATE &point3) {
+  return ((point1.x != point2.x || point1.y != point2.y) &&
+          (point3.x != point2.x || point3.y != point2.y));
+}
+
+/// @brief Computes the angle (in radians) between three points, where the
+/// second point is the vertex
+inline double computeAngle(const COORDINATE &point1, const COORDINATE &point2,
+                           const COORDINATE &point3) {
+  COORDINATE v1 = {point1.x - point2.x, point1.y - point2.y};
+  COORDINATE v2 = {point3.x - point2.x, point3.y - point2.y};
+
+  double dot_product = v1.x * v2.x + v1.y * v2.y;
+
+  double magnitude_v1 = std::sqrt(std::pow(v1.x, 2) + std::pow(v1.y, 2));
+  double magnitude_v2 = std::sqrt(std::pow(v2.x, 2) + std::pow(v2.y, 2));
+
+  // Rounding can take the cosine just outside [-1, 1], where acos() is NaN.
+  double cosine = dot_product / (magnitude_v1 * magnitude_v2);
+  return std::acos(std::max(-1.0, std::min(cosine, 1.0)));
+}
+
+/**
+ * @brief Angle test of LICs 2 and 9: the three points form a valid angle that
+ * is smaller than PI - EPSILON or larger than PI + EPSILON. The definition
+ * from the specification, which the LICs compute with angleOutsideBounds().
+ */
+inline bool angleOutsidePi(const COORDINATE &point1, const COORDINATE &point2,
+                           const COORDINATE &point3, double EPSILON) {
+  if (!validAngle(point1, point2, point3))
+    return false;
+  double angle = computeAngle(point1, point2, point3);
+  return lessWithTolerance(angle, PI - EPSILON) ||
+         greaterWithTolerance(angle, PI + EPSILON);
+}
+
+/**
+ * @brief The bounds of angleOutsidePi() for EPSILON. An angle compares LT to
+ * PI - EPSILON if it is at most PI - EPSILON - COMPARE_EPSILON, and GT to
+ * PI + EPSILON if it is at least PI + EPSILON + COMPARE_EPSILON. Bounds
+ * outside [0, PI] are never or always met, by coefficients 0 and a minimum of
+ * 1 or -1.
+ */
+inline ANGLE_BOUNDS_T angleBounds(double EPSILON) {
+  const double below = PI - EPSILON - COMPARE_EPSILON;
+  const double above = PI + EPSILON + COMPARE_EPSILON;
+  ANGLE_BOUNDS_T bounds = {0, 0, 1, 0, 0, 1};
+  if (below >= PI) {
+    bounds.below_min = -1;
+  } else if (below > 0) {
+    bounds.below_dot = std::sin(below);
+    bounds.below_cross = -std::cos(below);
+    bounds.below_min = 0;
+  }
+  if (above <= 0) {
+    bounds.above_min = -1;
+  } else if (above < PI) {
+    bounds.above_dot = -std::sin(above);
+    bounds.above_cross = std::cos(above);
+    bounds.above_min = 0;
+  }
+  return bounds;
+}
+
+// angleOutsidePi() with the bounds of angleBounds(EPSILON).
+inline bool angleOutsideBounds(const COORDINATE &point1,
+                               const COORDINATE &point2,
+                               const COORDINATE &point3,
+                               const ANGLE_BOUNDS_T &BOUNDS) {
+  const double v1x = point1.x - point2.x;
+  const double v1y = point1.y - point2.y;
+  const double v2x = point3.x - point2.x;
+  const double v2y = point3.y - point2.y;
+  const double dot = v1x * v2x + v1y * v2y;
+  const double cross = std::fabs(v1x * v2y - v1y * v2x);
+  const bool below =
+      BOUNDS.below_dot * dot + BOUNDS.below_cross * cross >= BOUNDS.below_min;
+  const bool above =
+      BOUNDS.above_dot * dot + BOUNDS.above_cross * cross >= BOUNDS.above_min;
+  return validAngle(point1, point2, point3) & (below | above);
+}
+
+/**
+ * @brief Quadrant (0 to 3 for I to IV) of a point in LIC 4. Points on an axis
+ * go to the lowest numbered quadrant they touch.
+ */
+inline int quadrant(const COORDINATE &p) {
+  // I = 0, II = 1, III = 2, IV = 3 from the signs, without branches
+  const int left = lessWithTolerance(p.x, 0.0);
+  const int below = lessWithTolerance(p.y, 0.0);
+  return left ^ (3 * below);
+}
+
+/**
+ * @brief Quadrants occupied by a sliding window of points (LIC 4). Points
+ * enter and leave the window by their quadrant, so moving the window by one
+ * point costs O(1) whatever its length.
+ */
+class QuadrantWindow {
+private:
+  int count[4];
+
+public:
+  int occupied; // quadrants with at least one point in the window
+
+  QuadrantWindow() : count{0, 0, 0, 0}, occupied(0) {}
+
+  void add(int QUADRANT) { occupied += count[QUADRANT]++ == 0; }
+  void remove(int QUADRANT) { occupied -= --count[QUADRANT] == 0; }
+};
+
+/**
+ * @brief LIC 6 test for one window of N_PTS consecutive points: at least one
+ * point lies further than DIST from the line through the first and last point
+ * of the window, or from the first point if the two coincide. LIMIT is
+ * greaterThanSquared(DIST), and the squared distances are compared against it
+ * exactly, with lineDistanceSign() and distanceSign(). WINDOW is anything
+ * whose [j] gives the j-th point of the window, a COORDINATE pointer or a
+ * POINTS_VIEW::from() the first point.
+ */
+template <typename WINDOW>
+inline bool lic6Window(const WINDOW &window, int N_PTS, double LIMIT) {
+  const COORDINATE first = window[0];
+  const COORDINATE last = window[N_PTS - 1];
+  const bool coincident = std::fabs(last.x - first.x) < COMPARE_EPSILON &&
+                          std::fabs(last.y - first.y) < COMPARE_EPSILON;
+  for (int j = 1; j < N_PTS - 1; ++j) {
+    const double sign = coincident
+                            ? distanceSign(first, window[j], LIMIT)
+                            : lineDistanceSign(first, last, window[j], LIMIT);
+    // "not less than" so that NaN counts as further, like DOUBLECOMPARE
+    if (!(sign < 0))
+      return true;
+  }
+  return false;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "incremental.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "unlock.h"
+#include <algorithm>
+
+IncrementalDecide::IncrementalDecide(const PARAMETERS_T &PARAMETERS,
+                                     const LCM_T &LCM,
+                                     const std::array<bool, 15> &PUV)
+    : PARAMETERS(PARAMETERS), LCM(LCM), PUV(PUV) {
+  const PARAMETERS_T &P = PARAMETERS;
+  // LIC 4 needs the point that just left its Q_PTS window, hence Q_PTS + 1.
+  span = std::max(3, P.Q_PTS + 1);
+  span = std::max(span, P.N_PTS);
+  span = std::max(span, P.K_PTS + 2);
+  span = std::max(span, P.A_PTS + P.B_PTS + 3);
+  span = std::max(span, P.C_PTS + P.D_PTS + 3);
+  span = std::max(span, P.E_PTS + P.F_PTS + 3);
+  span = std::max(span, P.G_PTS + 2);
+  angle_bounds = angleBounds(P.EPSILON);
+  radius1_diameter2 = circleDiameter2(P.RADIUS1);
+  radius2_diameter2 = circleDiameter2(P.RADIUS2);
+  length1_far = greaterThanSquared(P.LENGTH1);
+  length2_near = lessThanSquared(P.LENGTH2);
+  dist_far = greaterThanSquared(P.DIST);
+  area1_above = greaterThanDoubled(P.AREA1);
+  area2_below = lessThanDoubled(P.AREA2);
+
+  // Compacting only once the buffer holds 2 * span points keeps the cost of
+  // moving the last span points to the front at O(1) per appended point.
+  window.reserve(std::max(2 * span, 64));
+  reset();
+}
+
+void IncrementalDecide::reset() {
+  NUMPOINTS = 0;
+  window.clear();
+  window_start = 0;
+
+  found.fill(false);
+  found_lic12_length2 = false;
+  found_lic13_radius2 = false;
+  found_lic14_area2 = false;
+
+  quadrants = QuadrantWindow();
+  // An empty window covers no quadrants.
+  if (PARAMETERS.Q_PTS <= 0) {
+    found[4] = 0 > PARAMETERS.QUADS;
+  }
+}
+
+void IncrementalDecide::append(const COORDINATE &point) {
+  if (window.size() == window.capacity()) {
+    int keep = span - 1;
+    std::copy(window.end() - keep, window.end(), window.begin());
+    window.resize(keep);
+    window_start = NUMPOINTS - keep;
+  }
+  window.push_back(point);
+  ++NUMPOINTS;
+  update();
+}
+
+void IncrementalDecide::append(const std::vector<COORDINATE> &points) {
+  for (const COORDINATE &point : points) {
+    append(point);
+  }
+}
+
+void IncrementalDecide::update() {
+  const PARAMETERS_T &P = PARAMETERS;
+  const int n = NUMPOINTS - 1; // index of the newest point
+  const COORDINATE &last = at(n);
+
+  // Consecutive pairs
+  if (n >= 1) {
+    const COORDINATE &prev = at(n - 1);
+    if (!found[0] && !(squaredDistance(prev, last) < length1_far))
+      found[0] = true;
+    if (!found[5] && lessWithTolerance(last.x - prev.x, 0))
+      found[5] = true;
+  }
+
+  // Consecutive triples
+  if (n >= 2) {
+    const COORDINATE &p1 = at(n - 2);
+    const COORDINATE &p2 = at(n - 1);
+    if (!found[1] && !fitsInCircle(p1, p2, last, radius1_diameter2))
+      found[1] = true;
+    if (!found[2] && angleOutsideBounds(p1, p2, last, angle_bounds))
+      found[2] = true;
+    if (!found[3] && twiceAreaAtLeast(p1, p2, last, area1_above))
+      found[3] = true;
+  }
+
+  // Q_PTS window, kept up to date with one counter per quadrant
+  if (!found[4] && P.Q_PTS > 0) {
+    quadrants.add(quadrant(last));
+    if (n >= P.Q_PTS)
+      quadrants.remove(quadrant(at(n - P.Q_PTS)));
+    if (n + 1 >= P.Q_PTS && quadrants.occupied > P.QUADS)
+      found[4] = true;
+  }
+
+  // N_PTS window
+  if (!found[6] && P.N_PTS >= 3 && n + 1 >= P.N_PTS &&
+      lic6Window(&at(n - P.N_PTS + 1), P.N_PTS, dist_far))
+    found[6] = true;
+
+  // Pairs separated by K_PTS points
+  if (P.K_PTS >= 0 && n >= P.K_PTS + 1 &&
+      (!found[7] || !found[12] || !found_lic12_length2)) {
+    const double distance2 = squaredDistance(at(n - P.K_PTS - 1), last);
+    if (!(distance2 < length1_far))
+      found[7] = found[12] = true;
+    if (distance2 <= length2_near)
+      found_lic12_length2 = true;
+  }
+
+  // Triples separated by A_PTS and B_PTS points
+  if (P.A_PTS >= 0 && P.B_PTS >= 0 && n >= P.A_PTS + P.B_PTS + 2 &&
+      (!found[8] || !found_lic13_radius2)) {
+    const COORDINATE &first = at(n - P.A_PTS - P.B_PTS - 2);
+    const COORDINATE &vertex = at(n - P.B_PTS - 1);
+    if (!fitsInCircle(first, vertex, last, radius1_diameter2))
+      found[8] = found[13] = true;
+    if (fitsInCircle(first, vertex, last, radius2_diameter2))
+      found_lic13_radius2 = true;
+  }
+
+  // Triples separated by C_PTS and D_PTS points
+  if (!found[9] && P.C_PTS >= 0 && P.D_PTS >= 0 &&
+      n >= P.C_PTS + P.D_PTS + 2 &&
+      angleOutsideBounds(at(n - P.C_PTS - P.D_PTS - 2), at(n - P.D_PTS - 1),
+                         last, angle_bounds))
+    found[9] = true;
+
+  // Triples separated by E_PTS and F_PTS points
+  if (P.E_PTS >= 0 && P.F_PTS >= 0 && n >= P.E_PTS + P.F_PTS + 2 &&
+      (!found[10] || !found_lic14_area2)) {
+    const COORDINATE &first = at(n - P.E_PTS - P.F_PTS - 2);
+    const COORDINATE &vertex = at(n - P.F_PTS - 1);
+    if (twiceAreaAtLeast(first, vertex, last, area1_above))
+      found[10] = found[14] = true;
+    if (twiceAreaAtMost(first, vertex, last, area2_below))
+      found_lic14_area2 = true;
+  }
+
+  // Pairs separated by G_PTS points
+  if (!found[11] && P.G_PTS >= 0 && n >= P.G_PTS + 1 &&
+      lessWithTolerance(last.x - at(n - P.G_PTS - 1).x, 0))
+    found[11] = true;
+}
+
+std::array<bool, 15> IncrementalDecide::cmv() const {
+  std::array<bool, 15> CMV = found;
+  // Conditions that are not met for short tracks, whatever the points.
+  CMV[4] = CMV[4] && NUMPOINTS >= PARAMETERS.Q_PTS;
+  CMV[6] = CMV[6] && NUMPOINTS >= 3;
+  CMV[7] = CMV[7] && NUMPOINTS >= 3;
+  CMV[8] = CMV[8] && NUMPOINTS >= 5;
+  CMV[9] = CMV[9] && NUMPOINTS >= 5;
+  CMV[10] = CMV[10] && NUMPOINTS >= 5;
+  CMV[11] = CMV[11] && NUMPOINTS >= 3;
+  CMV[12] = CMV[12] && found_lic12_length2 && NUMPOINTS >= 3;
+  CMV[13] = CMV[13] && found_lic13_radius2 && NUMPOINTS >= 5;
+  CMV[14] = CMV[14] && found_lic14_area2 && NUMPOINTS >= 5;
+  return CMV;
+}
+
+bool IncrementalDecide::launch() const {
+  return launchFromCMV(cmv(), LCM, PUV);
+}
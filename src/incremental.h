@@ -0,0 +1,91 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "decide.h"
+#include "geometry.h"
+
+/**
+ * @brief Stateful, append-only version of Decide.
+ *
+ * Points are fed one (or a few) at a time with append(). Every LIC is a "there
+ * exists a set of points" condition, so each new point only has to be checked
+ * in the windows that end at it: pairs and triples at the configured gaps,
+ * the N_PTS window of LIC 6 and the Q_PTS window of LIC 4. A LIC that has
+ * been satisfied stays satisfied and is not looked at again.
+ *
+ * Only the last few points (the longest window) are kept, so memory does not
+ * grow with the length of the track. Appending costs O(1) amortised per point,
+ * except for LIC 6 which needs O(N_PTS) to check its window.
+ *
+ * The CMV and LAUNCH after appending a track are the same as those of Decide
+ * constructed with the whole track.
+ */
+class IncrementalDecide {
+private:
+  // Inputs
+  const PARAMETERS_T PARAMETERS; // Struct holding the parameters for LICs.
+  const LCM_T LCM;               // Logical Connector Matrix.
+  const std::array<bool, 15> PUV; // Preliminary unlocking vector.
+
+  int NUMPOINTS; // Number of points appended so far.
+
+  // Longest window (in points) any LIC looks at.
+  int span;
+  // The most recent points, window[0] being point number window_start.
+  std::vector<COORDINATE> window;
+  int window_start;
+
+  // found[i] is set once a set of points satisfying LIC i was seen. For LICs
+  // 12, 13 and 14 it only covers the first of their two conditions.
+  std::array<bool, 15> found;
+  bool found_lic12_length2;
+  bool found_lic13_radius2;
+  bool found_lic14_area2;
+
+  // Angle bounds of LICs 2 and 9, and the circles of RADIUS1 and RADIUS2 as
+  // circleDiameter2().
+  ANGLE_BOUNDS_T angle_bounds;
+  double radius1_diameter2;
+  double radius2_diameter2;
+  // Squared distances of LICs 0, 7, 12 and 6 and twice the areas of LICs 3,
+  // 10 and 14, see greaterThanSquared() and greaterThanDoubled(). Compared as
+  // Decide compares them, so that both agree at the tolerance bounds.
+  double length1_far;
+  double length2_near;
+  double dist_far;
+  double area1_above;
+  double area2_below;
+
+  // Quadrants of the current Q_PTS window (LIC 4).
+  QuadrantWindow quadrants;
+
+  // Returns the point with the given absolute index.
+  const COORDINATE &at(int index) const {
+    return window[index - window_start];
+  }
+
+  // Checks every window that ends at the newest point.
+  void update();
+
+public:
+  IncrementalDecide(const PARAMETERS_T &PARAMETERS, const LCM_T &LCM,
+                    const std::array<bool, 15> &PUV);
+
+  // Appends the next data point(s) of the track.
+  void append(const COORDINATE &point);
+  void append(const std::vector<COORDINATE> &points);
+
+  // Forgets every point appended so far.
+  void reset();
+
+  // Number of points appended so far.
+  int numpoints() const { return NUMPOINTS; }
+
+  // Conditions Met Vector of the points appended so far.
+  std::array<bool, 15> cmv() const;
+
+  // Launch decision for the points appended so far.
+  bool launch() const;
+};
+
+#endif
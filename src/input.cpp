@@ -0,0 +1,293 @@
+#include "input.h"
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// readTextInput() of input with room for at most MAX_POINTS points.
+static bool readText(std::istream &IN, long long MAX_POINTS,
+                     std::vector<COORDINATE> &POINTS, CONFIG_T &CONFIG,
+                     std::string &ERROR) {
+  int NUMPOINTS;
+  if (!(IN >> NUMPOINTS) || NUMPOINTS < 0) {
+    ERROR = "Invalid NUMPOINTS";
+    return false;
+  }
+  if (NUMPOINTS > MAX_POINTS) {
+    ERROR = "Input is shorter than its NUMPOINTS";
+    return false;
+  }
+
+  POINTS.clear();
+  for (int i = 0; i < NUMPOINTS; i++) {
+    COORDINATE point;
+    if (!(IN >> point.x >> point.y)) {
+      ERROR = "Invalid points";
+      return false;
+    }
+    POINTS.push_back(point);
+  }
+
+  PARAMETERS_T &parameters = CONFIG.PARAMETERS;
+  IN >> parameters.LENGTH1;
+  IN >> parameters.RADIUS1;
+  IN >> parameters.EPSILON;
+  IN >> parameters.AREA1;
+  IN >> parameters.Q_PTS;
+  IN >> parameters.QUADS;
+  IN >> parameters.DIST;
+  IN >> parameters.N_PTS;
+  IN >> parameters.K_PTS;
+  IN >> parameters.A_PTS;
+  IN >> parameters.B_PTS;
+  IN >> parameters.C_PTS;
+  IN >> parameters.D_PTS;
+  IN >> parameters.E_PTS;
+  IN >> parameters.F_PTS;
+  IN >> parameters.G_PTS;
+  IN >> parameters.LENGTH2;
+  IN >> parameters.RADIUS2;
+  IN >> parameters.AREA2;
+  if (!IN) {
+    ERROR = "Invalid parameters";
+    return false;
+  }
+
+  for (int i = 0; i < 15; i++) {
+    for (int j = 0; j < 15; j++) {
+      std::string temp;
+      IN >> temp;
+      if (temp == "ANDD") {
+        CONFIG.LCM[i][j] = ANDD;
+      } else if (temp == "ORR") {
+        CONFIG.LCM[i][j] = ORR;
+      } else if (temp == "NOTUSED") {
+        CONFIG.LCM[i][j] = NOTUSED;
+      } else {
+        ERROR = "Invalid connector";
+        return false;
+      }
+    }
+  }
+
+  for (int i = 0; i < 15; i++) {
+    std::string temp;
+    IN >> temp;
+    if (temp == "T") {
+      CONFIG.PUV[i] = true;
+    } else if (temp == "F") {
+      CONFIG.PUV[i] = false;
+    } else {
+      ERROR = "Invalid PUV " + temp;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool readTextInput(std::istream &IN, std::vector<COORDINATE> &POINTS,
+                   CONFIG_T &CONFIG, std::string &ERROR) {
+  return readText(IN, INT_MAX, POINTS, CONFIG, ERROR);
+}
+
+bool readTextInput(const char *DATA, size_t SIZE,
+                   std::vector<COORDINATE> &POINTS, CONFIG_T &CONFIG,
+                   std::string &ERROR) {
+  // A point takes two numbers and the whitespace after each.
+  MemoryBuffer buffer(DATA, SIZE);
+  std::istream in(&buffer);
+  return readText(in, (long long)(SIZE / 4), POINTS, CONFIG, ERROR);
+}
+
+static const char FRAME_MAGIC[8] = {'D', 'E', 'C', 'I', 'D', 'E', '0', '1'};
+
+// Field offsets, see input.h.
+static const size_t NUMPOINTS_OFFSET = 8;
+static const size_t PUV_OFFSET = FRAME_CONFIG_OFFSET;
+static const size_t DOUBLES_OFFSET = 16;
+static const size_t INTS_OFFSET = 80;
+static const size_t LCM_OFFSET = 128;
+
+static bool littleEndianHost() {
+  const uint32_t one = 1;
+  unsigned char first;
+  std::memcpy(&first, &one, 1);
+  return first == 1;
+}
+
+static void putUint32(char *frame, size_t offset, uint32_t value) {
+  for (int b = 0; b < 4; ++b) {
+    frame[offset + b] = (char)((value >> (8 * b)) & 0xff);
+  }
+}
+
+static void putDouble(char *frame, size_t offset, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof bits);
+  for (int b = 0; b < 8; ++b) {
+    frame[offset + b] = (char)((bits >> (8 * b)) & 0xff);
+  }
+}
+
+static uint32_t getUint32(const char *data, size_t offset) {
+  uint32_t value = 0;
+  for (int b = 0; b < 4; ++b) {
+    value |= (uint32_t)(unsigned char)data[offset + b] << (8 * b);
+  }
+  return value;
+}
+
+static double getDouble(const char *data, size_t offset) {
+  uint64_t bits = 0;
+  for (int b = 0; b < 8; ++b) {
+    bits |= (uint64_t)(unsigned char)data[offset + b] << (8 * b);
+  }
+  double value;
+  std::memcpy(&value, &bits, sizeof value);
+  return value;
+}
+
+// Parameters stored as doubles and as int32, in frame order.
+static double PARAMETERS_T::*const FRAME_DOUBLES[8] = {
+    &PARAMETERS_T::LENGTH1, &PARAMETERS_T::RADIUS1, &PARAMETERS_T::EPSILON,
+    &PARAMETERS_T::AREA1,   &PARAMETERS_T::DIST,    &PARAMETERS_T::LENGTH2,
+    &PARAMETERS_T::RADIUS2, &PARAMETERS_T::AREA2};
+static int PARAMETERS_T::*const FRAME_INTS[11] = {
+    &PARAMETERS_T::Q_PTS, &PARAMETERS_T::QUADS, &PARAMETERS_T::N_PTS,
+    &PARAMETERS_T::K_PTS, &PARAMETERS_T::A_PTS, &PARAMETERS_T::B_PTS,
+    &PARAMETERS_T::C_PTS, &PARAMETERS_T::D_PTS, &PARAMETERS_T::E_PTS,
+    &PARAMETERS_T::F_PTS, &PARAMETERS_T::G_PTS};
+
+bool isFrame(const char *DATA, size_t SIZE) {
+  return SIZE >= sizeof FRAME_MAGIC &&
+         std::memcmp(DATA, FRAME_MAGIC, sizeof FRAME_MAGIC) == 0;
+}
+
+void encodeConfig(const CONFIG_T &CONFIG, char *KEY) {
+  // Offsets within the header, less those of the bytes before KEY.
+  const size_t puv_offset = PUV_OFFSET - FRAME_CONFIG_OFFSET;
+  const size_t doubles_offset = DOUBLES_OFFSET - FRAME_CONFIG_OFFSET;
+  const size_t ints_offset = INTS_OFFSET - FRAME_CONFIG_OFFSET;
+  const size_t lcm_offset = LCM_OFFSET - FRAME_CONFIG_OFFSET;
+  std::memset(KEY, 0, FRAME_CONFIG_SIZE);
+
+  uint32_t puv = 0;
+  for (int i = 0; i < 15; ++i) {
+    if (CONFIG.PUV[i])
+      puv |= 1u << i;
+  }
+  putUint32(KEY, puv_offset, puv);
+
+  for (int i = 0; i < 8; ++i) {
+    putDouble(KEY, doubles_offset + 8 * i,
+              CONFIG.PARAMETERS.*FRAME_DOUBLES[i]);
+  }
+  for (int i = 0; i < 11; ++i) {
+    putUint32(KEY, ints_offset + 4 * i,
+              (uint32_t)(CONFIG.PARAMETERS.*FRAME_INTS[i]));
+  }
+
+  for (int k = 0; k < 15 * 15; ++k) {
+    CONNECTORS connector = CONFIG.LCM[k / 15][k % 15];
+    unsigned code = connector == ORR ? 1 : connector == ANDD ? 2 : 0;
+    unsigned char byte = KEY[lcm_offset + k / 4];
+    KEY[lcm_offset + k / 4] = (char)(byte | code << (2 * (k % 4)));
+  }
+}
+
+std::string encodeFrame(const std::vector<COORDINATE> &POINTS,
+                        const CONFIG_T &CONFIG) {
+  const size_t N = POINTS.size();
+  std::string frame(FRAME_HEADER_SIZE + 16 * N, '\0');
+
+  std::memcpy(&frame[0], FRAME_MAGIC, sizeof FRAME_MAGIC);
+  putUint32(&frame[0], NUMPOINTS_OFFSET, (uint32_t)N);
+  encodeConfig(CONFIG, &frame[FRAME_CONFIG_OFFSET]);
+
+  for (size_t i = 0; i < N; ++i) {
+    putDouble(&frame[0], FRAME_HEADER_SIZE + 8 * i, POINTS[i].x);
+    putDouble(&frame[0], FRAME_HEADER_SIZE + 8 * (N + i), POINTS[i].y);
+  }
+  return frame;
+}
+
+bool decodeFrame(const char *DATA, size_t SIZE, int &NUMPOINTS,
+                 POINTS_VIEW &POINTS, CONFIG_T &CONFIG, std::string &ERROR) {
+  if (SIZE < FRAME_HEADER_SIZE || !isFrame(DATA, SIZE)) {
+    ERROR = "Invalid frame header";
+    return false;
+  }
+  // The coordinates are used in place, as native doubles.
+  if (!littleEndianHost() || (uintptr_t)DATA % alignof(double) != 0) {
+    ERROR = "Frames need a little-endian host and 8-byte aligned data";
+    return false;
+  }
+
+  const uint32_t N = getUint32(DATA, NUMPOINTS_OFFSET);
+  if (N > (uint32_t)INT_MAX) {
+    ERROR = "Invalid NUMPOINTS";
+    return false;
+  }
+  if ((SIZE - FRAME_HEADER_SIZE) / 16 < N) {
+    ERROR = "Frame is shorter than its NUMPOINTS";
+    return false;
+  }
+  NUMPOINTS = (int)N;
+
+  const uint32_t puv = getUint32(DATA, PUV_OFFSET);
+  for (int i = 0; i < 15; ++i) {
+    CONFIG.PUV[i] = (puv >> i) & 1;
+  }
+
+  for (int i = 0; i < 8; ++i) {
+    CONFIG.PARAMETERS.*FRAME_DOUBLES[i] =
+        getDouble(DATA, DOUBLES_OFFSET + 8 * i);
+  }
+  for (int i = 0; i < 11; ++i) {
+    CONFIG.PARAMETERS.*FRAME_INTS[i] =
+        (int32_t)getUint32(DATA, INTS_OFFSET + 4 * i);
+  }
+
+  static const CONNECTORS CODES[3] = {NOTUSED, ORR, ANDD};
+  for (int k = 0; k < 15 * 15; ++k) {
+    unsigned code =
+        ((unsigned char)DATA[LCM_OFFSET + k / 4] >> (2 * (k % 4))) & 3;
+    if (code == 3) {
+      ERROR = "Invalid connector";
+      return false;
+    }
+    CONFIG.LCM[k / 15][k % 15] = CODES[code];
+  }
+
+  const double *x = reinterpret_cast<const double *>(DATA + FRAME_HEADER_SIZE);
+  POINTS = POINTS_VIEW(x, x + N);
+  return true;
+}
+
+MappedFile::MappedFile(const std::string &PATH)
+    : DATA(nullptr), SIZE(0), OPEN(false) {
+  int fd = open(PATH.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+  struct stat info;
+  if (fstat(fd, &info) == 0) {
+    SIZE = (size_t)info.st_size;
+    if (SIZE == 0) {
+      OPEN = true;
+    } else {
+      void *mapping = mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        DATA = static_cast<const char *>(mapping);
+        OPEN = true;
+      }
+    }
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (DATA != nullptr)
+    munmap(const_cast<char *>(DATA), SIZE);
+}
@@ -0,0 +1,103 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "decide.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+/**
+ * @brief Reads the text input of the decide program: NUMPOINTS, the points,
+ * the parameters in the order of PARAMETERS_T, the LCM as ANDD/ORR/NOTUSED
+ * and the PUV as T/F, all separated by whitespace (see
+ * test/example_input.txt). On error returns false and describes it in ERROR.
+ */
+bool readTextInput(std::istream &IN, std::vector<COORDINATE> &POINTS,
+                   CONFIG_T &CONFIG, std::string &ERROR);
+
+// Reads text input in place, without copying it into a string, for an
+// std::istream over a request or a mapped file.
+class MemoryBuffer : public std::streambuf {
+public:
+  MemoryBuffer(const char *DATA, size_t SIZE) {
+    char *begin = const_cast<char *>(DATA);
+    setg(begin, begin, begin + SIZE);
+  }
+};
+
+// readTextInput() of the SIZE bytes at DATA, read in place. Also rejects a
+// NUMPOINTS that cannot fit in them before allocating anything for it.
+bool readTextInput(const char *DATA, size_t SIZE,
+                   std::vector<COORDINATE> &POINTS, CONFIG_T &CONFIG,
+                   std::string &ERROR);
+
+/*
+ * Binary frame format. All fields are little-endian and every double is at
+ * an offset that is a multiple of 8, so that a mapped frame can be evaluated
+ * in place.
+ *
+ *   offset  size       field
+ *        0     8       magic "DECIDE01"
+ *        8     4       uint32 NUMPOINTS, at most INT_MAX
+ *       12     4       uint32 PUV, bit i is PUV[i]
+ *       16    64       LENGTH1, RADIUS1, EPSILON, AREA1, DIST, LENGTH2,
+ *                      RADIUS2, AREA2 as doubles
+ *       80    48       Q_PTS, QUADS, N_PTS, K_PTS, A_PTS to G_PTS as int32,
+ *                      then 4 bytes of padding
+ *      128    64       LCM, 2 bits per entry (0 NOTUSED, 1 ORR, 2 ANDD),
+ *                      entry 15 * y + x at bits 2 * (k % 4) of byte k / 4
+ *      192  8 * N      x coordinates as doubles
+ *  192+8*N  8 * N      y coordinates as doubles
+ */
+const size_t FRAME_HEADER_SIZE = 192;
+
+// The bytes of a header that hold the configuration, from the PUV on.
+const size_t FRAME_CONFIG_OFFSET = 12;
+const size_t FRAME_CONFIG_SIZE = FRAME_HEADER_SIZE - FRAME_CONFIG_OFFSET;
+
+// Returns true if the data starts with the magic of a binary frame.
+bool isFrame(const char *DATA, size_t SIZE);
+
+// Writes the FRAME_CONFIG_SIZE header bytes of CONFIG to KEY, as they are in
+// a frame from FRAME_CONFIG_OFFSET on. Equal bytes mean equal configurations,
+// so they can serve as a key for them.
+void encodeConfig(const CONFIG_T &CONFIG, char *KEY);
+
+// Encodes points and configuration as a binary frame.
+std::string encodeFrame(const std::vector<COORDINATE> &POINTS,
+                        const CONFIG_T &CONFIG);
+
+/**
+ * @brief Decodes a binary frame without copying the points: POINTS views the
+ * coordinates inside DATA, which must outlive it. DATA must be aligned to 8
+ * bytes, as mapped files are. On error returns false and describes it in
+ * ERROR.
+ */
+bool decodeFrame(const char *DATA, size_t SIZE, int &NUMPOINTS,
+                 POINTS_VIEW &POINTS, CONFIG_T &CONFIG, std::string &ERROR);
+
+/**
+ * @brief Read-only memory mapping of a whole file, released on destruction.
+ */
+class MappedFile {
+private:
+  const char *DATA;
+  size_t SIZE;
+  bool OPEN;
+
+public:
+  explicit MappedFile(const std::string &PATH);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // False if the file could not be opened or mapped.
+  bool isOpen() const { return OPEN; }
+  const char *data() const { return DATA; }
+  size_t size() const { return SIZE; }
+};
+
+#endif
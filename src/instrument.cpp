@@ -0,0 +1,133 @@
+#include "instrument.h"
+#include <atomic>
+
+namespace {
+struct Totals {
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> total_ns;
+  std::atomic<uint64_t> max_ns;
+  std::atomic<uint64_t> points;
+  std::atomic<uint64_t> early_exits;
+  std::atomic<int64_t> last_exit; // index + 1, so that zero means none
+};
+} // namespace
+
+// Zero initialized, before anything can record.
+static Totals TOTALS[PROBE_COUNT];
+
+bool probesEnabled() {
+#ifdef DECIDE_INSTRUMENT
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *probeName(int PROBE) {
+  static const char *const NAMES[PROBE_COUNT] = {
+      "Lic0",  "Lic1",  "Lic2",     "Lic3",     "Lic4",       "Lic5",
+      "Lic6",  "Lic7",  "Lic8",     "Lic9",     "Lic10",      "Lic11",
+      "Lic12", "Lic13", "Lic14",    "Calc_PUM", "Calc_FUV",   "Calc_LAUNCH"};
+  return NAMES[PROBE];
+}
+
+PROBE_STATS_T probeStats(int PROBE) {
+  const Totals &t = TOTALS[PROBE];
+  PROBE_STATS_T stats;
+  stats.CALLS = t.calls.load(std::memory_order_relaxed);
+  stats.TOTAL_NS = t.total_ns.load(std::memory_order_relaxed);
+  stats.MAX_NS = t.max_ns.load(std::memory_order_relaxed);
+  stats.POINTS_VISITED = t.points.load(std::memory_order_relaxed);
+  stats.EARLY_EXITS = t.early_exits.load(std::memory_order_relaxed);
+  stats.LAST_EXIT_INDEX = t.last_exit.load(std::memory_order_relaxed) - 1;
+  return stats;
+}
+
+void resetProbes() {
+  for (Totals &t : TOTALS) {
+    t.calls = 0;
+    t.total_ns = 0;
+    t.max_ns = 0;
+    t.points = 0;
+    t.early_exits = 0;
+    t.last_exit = 0;
+  }
+}
+
+void recordProbe(int PROBE, uint64_t NANOSECONDS, uint64_t POINTS,
+                 int64_t EXIT_INDEX) {
+  Totals &t = TOTALS[PROBE];
+  t.calls.fetch_add(1, std::memory_order_relaxed);
+  t.total_ns.fetch_add(NANOSECONDS, std::memory_order_relaxed);
+  t.points.fetch_add(POINTS, std::memory_order_relaxed);
+  uint64_t max = t.max_ns.load(std::memory_order_relaxed);
+  while (NANOSECONDS > max &&
+         !t.max_ns.compare_exchange_weak(max, NANOSECONDS,
+                                         std::memory_order_relaxed)) {
+  }
+  if (EXIT_INDEX >= 0) {
+    t.early_exits.fetch_add(1, std::memory_order_relaxed);
+    t.last_exit.store(EXIT_INDEX + 1, std::memory_order_relaxed);
+  }
+}
+
+void writeProbesJson(std::ostream &OUT) {
+  OUT << "{\"enabled\": " << (probesEnabled() ? "true" : "false")
+      << ", \"probes\": [";
+  for (int p = 0; p < PROBE_COUNT; ++p) {
+    const PROBE_STATS_T s = probeStats(p);
+    OUT << (p == 0 ? "\n" : ",\n") << "  {\"name\": \"" << probeName(p)
+        << "\", \"calls\": " << s.CALLS << ", \"total_ns\": " << s.TOTAL_NS
+        << ", \"max_ns\": " << s.MAX_NS
+        << ", \"points_visited\": " << s.POINTS_VISITED
+        << ", \"early_exits\": " << s.EARLY_EXITS
+        << ", \"last_exit_index\": " << s.LAST_EXIT_INDEX << "}";
+  }
+  OUT << "\n]}\n";
+}
+
+// One metric family of the Prometheus dump.
+struct Metric {
+  const char *NAME;
+  const char *TYPE;
+  const char *HELP;
+  double (*VALUE)(const PROBE_STATS_T &);
+};
+
+static double calls(const PROBE_STATS_T &s) { return s.CALLS; }
+static double seconds(const PROBE_STATS_T &s) { return s.TOTAL_NS * 1e-9; }
+static double maxSeconds(const PROBE_STATS_T &s) { return s.MAX_NS * 1e-9; }
+static double points(const PROBE_STATS_T &s) { return s.POINTS_VISITED; }
+static double exits(const PROBE_STATS_T &s) { return s.EARLY_EXITS; }
+static double lastExit(const PROBE_STATS_T &s) { return s.LAST_EXIT_INDEX; }
+
+void writeProbesPrometheus(std::ostream &OUT) {
+  static const Metric METRICS[] = {
+      {"decide_probe_calls_total", "counter", "Calls of the step.", calls},
+      {"decide_probe_seconds_total", "counter",
+       "Wall time spent in the step.", seconds},
+      {"decide_probe_max_seconds", "gauge", "Wall time of the slowest call.",
+       maxSeconds},
+      {"decide_probe_points_visited_total", "counter",
+       "Data points the step started a window at.", points},
+      {"decide_probe_early_exits_total", "counter",
+       "Calls that stopped before the last window.", exits},
+      {"decide_probe_last_exit_index", "gauge",
+       "Point of the last early exit, -1 if none.", lastExit}};
+
+  // Counts are exact as doubles up to 2^53.
+  const std::streamsize precision = OUT.precision(15);
+  OUT << "# HELP decide_probes_enabled Whether the build has "
+         "DECIDE_INSTRUMENT.\n"
+      << "# TYPE decide_probes_enabled gauge\n"
+      << "decide_probes_enabled " << (probesEnabled() ? 1 : 0) << "\n";
+  for (const Metric &m : METRICS) {
+    OUT << "# HELP " << m.NAME << " " << m.HELP << "\n"
+        << "# TYPE " << m.NAME << " " << m.TYPE << "\n";
+    for (int p = 0; p < PROBE_COUNT; ++p) {
+      OUT << m.NAME << "{probe=\"" << probeName(p) << "\"} "
+          << m.VALUE(probeStats(p)) << "\n";
+    }
+  }
+  OUT.precision(precision);
+}
@@ -0,0 +1,106 @@
+#ifndef INSTRUMENT_H
+#define INSTRUMENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Opt-in counters and timers on the hot path of Decide. They are compiled in
+// only when DECIDE_INSTRUMENT is defined (cmake -DDECIDE_INSTRUMENT=ON, or
+// make INSTRUMENT=1); otherwise Probe is empty and costs nothing.
+
+// Instrumented steps. LICs 0 to 14 are probes 0 to 14, the steps after the
+// CMV follow.
+enum PROBE_ID {
+  PROBE_CALC_PUM = 15,
+  PROBE_CALC_FUV,
+  PROBE_CALC_LAUNCH,
+  PROBE_COUNT
+};
+
+/**
+ * @brief Totals of one instrumented step since the last resetProbes().
+ *
+ * A LIC visits one point for every window (or pair) it tests, starting at
+ * that point. It exits early at the first window that meets it, and the exit
+ * index is the first point of that window.
+ */
+typedef struct {
+  uint64_t CALLS;
+  uint64_t TOTAL_NS; // wall time of all calls
+  uint64_t MAX_NS;   // wall time of the slowest call
+  uint64_t POINTS_VISITED;
+  uint64_t EARLY_EXITS;
+  int64_t LAST_EXIT_INDEX; // -1 if it never exited early
+} PROBE_STATS_T;
+
+// Whether this build has DECIDE_INSTRUMENT. If not, all totals stay zero.
+bool probesEnabled();
+
+// Name of a step in the dumps, "Lic0" to "Lic14", "Calc_PUM", ...
+const char *probeName(int PROBE);
+
+PROBE_STATS_T probeStats(int PROBE);
+void resetProbes();
+
+/**
+ * @brief Writes the totals of every step as one JSON object:
+ * {"enabled": true, "probes": [{"name": "Lic0", "calls": 1, ...}, ...]}
+ */
+void writeProbesJson(std::ostream &OUT);
+
+/**
+ * @brief Writes the totals of every step in the Prometheus text exposition
+ * format, one metric family per field with a "probe" label.
+ */
+void writeProbesPrometheus(std::ostream &OUT);
+
+// Adds one call to the totals of a step. Thread safe.
+void recordProbe(int PROBE, uint64_t NANOSECONDS, uint64_t POINTS,
+                 int64_t EXIT_INDEX);
+
+#ifdef DECIDE_INSTRUMENT
+/**
+ * @brief Times one call of a step, from construction to destruction, and
+ * records it with the points visited and the early exit reported meanwhile.
+ */
+class Probe {
+private:
+  const int PROBE;
+  const std::chrono::steady_clock::time_point START;
+  uint64_t points;
+  int64_t exit_index;
+
+public:
+  explicit Probe(int PROBE)
+      : PROBE(PROBE), START(std::chrono::steady_clock::now()), points(0),
+        exit_index(-1) {}
+  ~Probe() {
+    std::chrono::nanoseconds elapsed =
+        std::chrono::steady_clock::now() - START;
+    recordProbe(PROBE, elapsed.count(), points, exit_index);
+  }
+  Probe(const Probe &) = delete;
+  Probe &operator=(const Probe &) = delete;
+
+  // Counts POINTS more visited points.
+  void visit(int64_t POINTS) {
+    if (POINTS > 0)
+      points += POINTS;
+  }
+  // The step stopped early at INDEX, after visiting the points up to it.
+  void exitAt(int64_t INDEX) {
+    visit(INDEX + 1);
+    exit_index = INDEX;
+  }
+};
+#else
+class Probe {
+public:
+  explicit Probe(int) {}
+  void visit(int64_t) {}
+  void exitAt(int64_t) {}
+};
+#endif
+
+#endif
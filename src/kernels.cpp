@@ -0,0 +1,613 @@
+#include "kernels.h"
+#include "geometry.h"
+#include <cmath>
+
+double greaterThanSquared(double LENGTH) {
+  // d > LENGTH with tolerance means d >= LENGTH + COMPARE_EPSILON.
+  double limit = LENGTH + COMPARE_EPSILON;
+  return limit > 0 ? limit * limit : 0;
+}
+
+double lessThanSquared(double LENGTH) {
+  // d < LENGTH with tolerance means d <= LENGTH - COMPARE_EPSILON.
+  double limit = LENGTH - COMPARE_EPSILON;
+  return limit >= 0 ? limit * limit : -1;
+}
+
+double greaterThanDoubled(double AREA) { return 2 * (AREA + COMPARE_EPSILON); }
+
+double lessThanDoubled(double AREA) { return 2 * (AREA - COMPARE_EPSILON); }
+
+// Number of pairs compared between two checks for an early exit.
+static const int BLOCK = 16;
+
+// The gap scans are class templates on their gaps, see gapKernels(). A gap of
+// RUNTIME_GAP stands for the one given at run time, the functions declared in
+// kernels.h.
+static const int RUNTIME_GAP = 0;
+
+template <int GAP> static inline int fixedGap(int gap) {
+  return GAP == RUNTIME_GAP ? gap : GAP;
+}
+
+template <int GAP> struct PairAtLeast {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                  double limit);
+};
+
+template <int GAP> struct PairAtMost {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                  double limit);
+};
+
+template <int GAP> struct Decrease {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap);
+};
+
+// ABOVE selects between firstAreaAbove() and firstAreaBelow(), and between
+// firstRadiusAbove() and firstRadiusWithin().
+template <bool ABOVE, int GAP1, int GAP2> struct Area {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                  int gap2, double AREA);
+};
+
+template <bool ABOVE, int GAP1, int GAP2> struct Radius {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                  int gap2, double RADIUS);
+};
+
+template <int GAP1, int GAP2> struct AngleOutside {
+  static int scan(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                  int gap2, const ANGLE_BOUNDS_T &BOUNDS);
+};
+
+bool anyPairFarther(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double LENGTH) {
+  return anyPairAtLeast(POINTS, NUMPOINTS, gap, greaterThanSquared(LENGTH));
+}
+
+bool anyPairCloser(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                   double LENGTH) {
+  return anyPairAtMost(POINTS, NUMPOINTS, gap, lessThanSquared(LENGTH));
+}
+
+bool anyPairAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double limit) {
+  return firstPairAtLeast(POINTS, NUMPOINTS, gap, limit) >= 0;
+}
+
+int firstPairAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                     double limit) {
+  return PairAtLeast<RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap, limit);
+}
+
+template <int GAP>
+int PairAtLeast<GAP>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                           int RUNTIME, double limit) {
+  const int gap = fixedGap<GAP>(RUNTIME);
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const int s = POINTS.stride;
+  const int pairs = NUMPOINTS - gap;
+  int i = 0;
+
+#if defined(__SSE2__)
+  const __m128d vlimit = _mm_set1_pd(limit);
+  while (s == 1 && i + BLOCK <= pairs) {
+    __m128d hit = _mm_setzero_pd();
+    for (int end = i + BLOCK; i < end; i += 2) {
+      __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+      __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i + gap), _mm_loadu_pd(y + i));
+      __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      // "not less than" so that NaN counts as farther, like DOUBLECOMPARE
+      hit = _mm_or_pd(hit, _mm_cmpnlt_pd(d2, vlimit));
+    }
+    if (_mm_movemask_pd(hit) != 0) {
+      // Find the pair within the block, with the very same arithmetic.
+      for (i -= BLOCK;; i += 2) {
+        __m128d dx =
+            _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+        __m128d dy =
+            _mm_sub_pd(_mm_loadu_pd(y + i + gap), _mm_loadu_pd(y + i));
+        __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        int mask = _mm_movemask_pd(_mm_cmpnlt_pd(d2, vlimit));
+        if (mask != 0)
+          return (mask & 1) ? i : i + 1;
+      }
+    }
+  }
+#endif
+
+  for (; i < pairs; ++i) {
+    double dx = x[(i + gap) * s] - x[i * s];
+    double dy = y[(i + gap) * s] - y[i * s];
+    if (!(dx * dx + dy * dy < limit))
+      return i;
+  }
+  return -1;
+}
+
+bool anyPairAtMost(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                   double limit) {
+  return firstPairAtMost(POINTS, NUMPOINTS, gap, limit) >= 0;
+}
+
+int firstPairAtMost(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double limit) {
+  return PairAtMost<RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap, limit);
+}
+
+template <int GAP>
+int PairAtMost<GAP>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                          int RUNTIME, double limit) {
+  const int gap = fixedGap<GAP>(RUNTIME);
+  if (limit < 0)
+    return -1;
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const int s = POINTS.stride;
+  const int pairs = NUMPOINTS - gap;
+  int i = 0;
+
+#if defined(__SSE2__)
+  const __m128d vlimit = _mm_set1_pd(limit);
+  while (s == 1 && i + BLOCK <= pairs) {
+    __m128d hit = _mm_setzero_pd();
+    for (int end = i + BLOCK; i < end; i += 2) {
+      __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+      __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i + gap), _mm_loadu_pd(y + i));
+      __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+      hit = _mm_or_pd(hit, _mm_cmple_pd(d2, vlimit));
+    }
+    if (_mm_movemask_pd(hit) != 0) {
+      for (i -= BLOCK;; i += 2) {
+        __m128d dx =
+            _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+        __m128d dy =
+            _mm_sub_pd(_mm_loadu_pd(y + i + gap), _mm_loadu_pd(y + i));
+        __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        int mask = _mm_movemask_pd(_mm_cmple_pd(d2, vlimit));
+        if (mask != 0)
+          return (mask & 1) ? i : i + 1;
+      }
+    }
+  }
+#endif
+
+  for (; i < pairs; ++i) {
+    double dx = x[(i + gap) * s] - x[i * s];
+    double dy = y[(i + gap) * s] - y[i * s];
+    if (dx * dx + dy * dy <= limit)
+      return i;
+  }
+  return -1;
+}
+
+bool anyWindowFarFromLine(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                          double DIST) {
+  return anyWindowAtLeast(POINTS, NUMPOINTS, N_PTS, greaterThanSquared(DIST));
+}
+
+bool anyWindowAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                      double limit) {
+  return firstWindowAtLeast(POINTS, NUMPOINTS, N_PTS, limit) >= 0;
+}
+
+int firstWindowAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                       double limit) {
+  if (N_PTS < 3)
+    return -1;
+  const int windows = NUMPOINTS - N_PTS + 1;
+  int i = 0;
+
+#if defined(__SSE2__)
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const __m128d vlimit = _mm_set1_pd(limit);
+  const __m128d margin = _mm_set1_pd(std::fabs(limit));
+  const __m128d veps = _mm_set1_pd(COMPARE_EPSILON);
+  const __m128d one = _mm_set1_pd(1);
+  const __m128d error = _mm_set1_pd(-FILTER_ERROR);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  for (; POINTS.stride == 1 && i + 2 <= windows; i += 2) {
+    // Lanes hold windows i and i + 1.
+    const __m128d x1 = _mm_loadu_pd(x + i);
+    const __m128d y1 = _mm_loadu_pd(y + i);
+    const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i + N_PTS - 1), x1);
+    const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i + N_PTS - 1), y1);
+    const __m128d coincident =
+        _mm_and_pd(_mm_cmplt_pd(_mm_andnot_pd(sign, dx), veps),
+                   _mm_cmplt_pd(_mm_andnot_pd(sign, dy), veps));
+    const __m128d length2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+    const __m128d line_limit = _mm_mul_pd(vlimit, length2);
+    const __m128d threshold = _mm_or_pd(_mm_and_pd(coincident, vlimit),
+                                        _mm_andnot_pd(coincident, line_limit));
+    // The error bounds of lineDistanceSign() and distanceSign() are at most
+    // FILTER_ERROR (length2 + 1) (point + |limit|), as the terms of the cross
+    // product are at most sqrt(length2 * point).
+    const __m128d scale = _mm_mul_pd(error, _mm_add_pd(length2, one));
+
+    // Points that may be far enough: those that are, and those too close to
+    // call in floating point, which the lane then decides exactly.
+    __m128d hit = _mm_setzero_pd();
+    for (int j = 1; j < N_PTS - 1; ++j) {
+      const __m128d qx = _mm_sub_pd(_mm_loadu_pd(x + i + j), x1);
+      const __m128d qy = _mm_sub_pd(_mm_loadu_pd(y + i + j), y1);
+      const __m128d cross = _mm_sub_pd(_mm_mul_pd(dx, qy), _mm_mul_pd(qx, dy));
+      const __m128d point =
+          _mm_add_pd(_mm_mul_pd(qx, qx), _mm_mul_pd(qy, qy));
+      const __m128d value =
+          _mm_or_pd(_mm_and_pd(coincident, point),
+                    _mm_andnot_pd(coincident, _mm_mul_pd(cross, cross)));
+      const __m128d bound = _mm_mul_pd(scale, _mm_add_pd(point, margin));
+      hit = _mm_or_pd(hit,
+                      _mm_cmpnlt_pd(_mm_sub_pd(value, threshold), bound));
+    }
+    const int mask = _mm_movemask_pd(hit);
+    for (int lane = 0; lane < 2 && mask != 0; ++lane) {
+      if (((mask >> lane) & 1) &&
+          lic6Window(POINTS.from(i + lane), N_PTS, limit))
+        return i + lane;
+    }
+  }
+#endif
+
+  for (; i < windows; ++i) {
+    if (lic6Window(POINTS.from(i), N_PTS, limit))
+      return i;
+  }
+  return -1;
+}
+
+int firstDecrease(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap) {
+  return Decrease<RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap);
+}
+
+template <int GAP>
+int Decrease<GAP>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                        int RUNTIME) {
+  const int gap = fixedGap<GAP>(RUNTIME);
+  const double *x = POINTS.x;
+  const int s = POINTS.stride;
+  const int pairs = NUMPOINTS - gap;
+  int i = 0;
+
+#if defined(__SSE2__)
+  const __m128d zero = _mm_setzero_pd();
+  for (; s == 1 && i + 2 <= pairs; i += 2) {
+    const __m128d dx =
+        _mm_sub_pd(_mm_loadu_pd(x + i + gap), _mm_loadu_pd(x + i));
+    const int mask = _mm_movemask_pd(lessMask(dx, zero));
+    if (mask != 0)
+      return (mask & 1) ? i : i + 1;
+  }
+#endif
+
+  for (; i < pairs; ++i) {
+    if (lessWithTolerance(x[(i + gap) * s] - x[i * s], 0))
+      return i;
+  }
+  return -1;
+}
+
+// Area test of the window starting at point i, see Area::scan().
+template <bool ABOVE>
+static bool areaWindow(const POINTS_VIEW &POINTS, int i, int gap1, int gap2,
+                       double limit) {
+  const COORDINATE p1 = POINTS[i];
+  const COORDINATE p2 = POINTS[i + gap1];
+  const COORDINATE p3 = POINTS[i + gap1 + gap2];
+  return ABOVE ? twiceAreaAtLeast(p1, p2, p3, limit)
+               : twiceAreaAtMost(p1, p2, p3, limit);
+}
+
+template <bool ABOVE, int GAP1, int GAP2>
+int Area<ABOVE, GAP1, GAP2>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                                  int RUNTIME1, int RUNTIME2, double AREA) {
+  const int gap1 = fixedGap<GAP1>(RUNTIME1);
+  const int gap2 = fixedGap<GAP2>(RUNTIME2);
+  const int windows = NUMPOINTS - gap1 - gap2;
+  const double limit = ABOVE ? greaterThanDoubled(AREA) : lessThanDoubled(AREA);
+  int i = 0;
+
+#if defined(__SSE2__)
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const __m128d vlimit = _mm_set1_pd(limit);
+  const __m128d error = _mm_set1_pd(FILTER_ERROR);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  for (; POINTS.stride == 1 && i + 2 <= windows; i += 2) {
+    // twiceAreaSign() term by term, in the same order
+    const int j = i + gap1;
+    const int k = j + gap2;
+    const __m128d x1 = _mm_loadu_pd(x + i), y1 = _mm_loadu_pd(y + i);
+    const __m128d x2 = _mm_loadu_pd(x + j), y2 = _mm_loadu_pd(y + j);
+    const __m128d x3 = _mm_loadu_pd(x + k), y3 = _mm_loadu_pd(y + k);
+    const __m128d left =
+        _mm_mul_pd(_mm_sub_pd(x2, x1), _mm_sub_pd(y3, y1));
+    const __m128d right =
+        _mm_mul_pd(_mm_sub_pd(y2, y1), _mm_sub_pd(x3, x1));
+    const __m128d difference = _mm_sub_pd(
+        _mm_andnot_pd(sign, _mm_sub_pd(left, right)), vlimit);
+    const __m128d bound = _mm_mul_pd(
+        error,
+        _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+    // Windows that may meet the threshold: those that do, and those too close
+    // to call in floating point, which are then decided exactly.
+    const int mask = _mm_movemask_pd(
+        ABOVE ? _mm_cmpnlt_pd(difference, _mm_xor_pd(sign, bound))
+              : _mm_cmple_pd(difference, bound));
+    for (int lane = 0; lane < 2 && mask != 0; ++lane) {
+      if (((mask >> lane) & 1) &&
+          areaWindow<ABOVE>(POINTS, i + lane, gap1, gap2, limit))
+        return i + lane;
+    }
+  }
+#endif
+
+  for (; i < windows; ++i) {
+    if (areaWindow<ABOVE>(POINTS, i, gap1, gap2, limit))
+      return i;
+  }
+  return -1;
+}
+
+int firstAreaAbove(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                   int gap2, double AREA) {
+  return Area<true, RUNTIME_GAP, RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap1,
+                                                   gap2, AREA);
+}
+
+int firstAreaBelow(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                   int gap2, double AREA) {
+  return Area<false, RUNTIME_GAP, RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap1,
+                                                    gap2, AREA);
+}
+
+template <bool ABOVE, int GAP1, int GAP2>
+int Radius<ABOVE, GAP1, GAP2>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                                    int RUNTIME1, int RUNTIME2,
+                                    double RADIUS) {
+  const int gap1 = fixedGap<GAP1>(RUNTIME1);
+  const int gap2 = fixedGap<GAP2>(RUNTIME2);
+  const int windows = NUMPOINTS - gap1 - gap2;
+  const double diameter2 = circleDiameter2(RADIUS);
+  int i = 0;
+
+#if defined(__SSE2__)
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const __m128d limit = _mm_set1_pd(diameter2);
+  const __m128d two = _mm_set1_pd(2);
+  const __m128d four = _mm_set1_pd(4);
+  const __m128d limit3 = _mm_set1_pd(3 * diameter2);
+  for (; POINTS.stride == 1 && i + 2 <= windows; i += 2) {
+    // fitsInCircle() term by term, in the same order
+    const int j = i + gap1;
+    const int k = j + gap2;
+    const __m128d x1 = _mm_loadu_pd(x + i), y1 = _mm_loadu_pd(y + i);
+    const __m128d x2 = _mm_loadu_pd(x + j), y2 = _mm_loadu_pd(y + j);
+    const __m128d x3 = _mm_loadu_pd(x + k), y3 = _mm_loadu_pd(y + k);
+    const __m128d ux = _mm_sub_pd(x2, x1), uy = _mm_sub_pd(y2, y1);
+    const __m128d vx = _mm_sub_pd(x3, x1), vy = _mm_sub_pd(y3, y1);
+    const __m128d wx = _mm_sub_pd(x3, x2), wy = _mm_sub_pd(y3, y2);
+    const __m128d c2 = _mm_add_pd(_mm_mul_pd(ux, ux), _mm_mul_pd(uy, uy));
+    const __m128d b2 = _mm_add_pd(_mm_mul_pd(vx, vx), _mm_mul_pd(vy, vy));
+    const __m128d a2 = _mm_add_pd(_mm_mul_pd(wx, wx), _mm_mul_pd(wy, wy));
+    const __m128d longest2 = _mm_max_pd(_mm_max_pd(a2, b2), c2);
+    const __m128d cross = _mm_sub_pd(_mm_mul_pd(ux, vy), _mm_mul_pd(uy, vx));
+    const __m128d not_acute = _mm_cmpge_pd(
+        _mm_mul_pd(two, longest2), _mm_add_pd(_mm_add_pd(a2, b2), c2));
+    const __m128d small = _mm_cmplt_pd(_mm_mul_pd(four, longest2), limit3);
+    const __m128d circumcircle =
+        _mm_cmplt_pd(_mm_mul_pd(_mm_mul_pd(a2, b2), c2),
+                     _mm_mul_pd(_mm_mul_pd(limit, cross), cross));
+    const __m128d fits =
+        _mm_and_pd(_mm_cmplt_pd(longest2, limit),
+                   _mm_or_pd(_mm_or_pd(not_acute, small), circumcircle));
+    const int mask = _mm_movemask_pd(fits) ^ (ABOVE ? 3 : 0);
+    if (mask != 0)
+      return (mask & 1) ? i : i + 1;
+  }
+#endif
+
+  for (; i < windows; ++i) {
+    if (fitsInCircle(POINTS[i], POINTS[i + gap1], POINTS[i + gap1 + gap2],
+                     diameter2) != ABOVE)
+      return i;
+  }
+  return -1;
+}
+
+int firstRadiusAbove(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                     int gap2, double RADIUS) {
+  return Radius<true, RUNTIME_GAP, RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap1,
+                                                     gap2, RADIUS);
+}
+
+int firstRadiusWithin(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                      int gap2, double RADIUS) {
+  return Radius<false, RUNTIME_GAP, RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap1,
+                                                      gap2, RADIUS);
+}
+
+template <int GAP1, int GAP2>
+int AngleOutside<GAP1, GAP2>::scan(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                                   int RUNTIME1, int RUNTIME2,
+                                   const ANGLE_BOUNDS_T &BOUNDS) {
+  const int gap1 = fixedGap<GAP1>(RUNTIME1);
+  const int gap2 = fixedGap<GAP2>(RUNTIME2);
+  const int windows = NUMPOINTS - gap1 - gap2;
+  int i = 0;
+
+#if defined(__SSE2__)
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const __m128d below_dot = _mm_set1_pd(BOUNDS.below_dot);
+  const __m128d below_cross = _mm_set1_pd(BOUNDS.below_cross);
+  const __m128d below_min = _mm_set1_pd(BOUNDS.below_min);
+  const __m128d above_dot = _mm_set1_pd(BOUNDS.above_dot);
+  const __m128d above_cross = _mm_set1_pd(BOUNDS.above_cross);
+  const __m128d above_min = _mm_set1_pd(BOUNDS.above_min);
+  const __m128d sign = _mm_set1_pd(-0.0);
+  for (; POINTS.stride == 1 && i + 2 <= windows; i += 2) {
+    // angleOutsideBounds() term by term, in the same order
+    const int j = i + gap1;
+    const int k = j + gap2;
+    const __m128d x1 = _mm_loadu_pd(x + i), y1 = _mm_loadu_pd(y + i);
+    const __m128d x2 = _mm_loadu_pd(x + j), y2 = _mm_loadu_pd(y + j);
+    const __m128d x3 = _mm_loadu_pd(x + k), y3 = _mm_loadu_pd(y + k);
+    const __m128d v1x = _mm_sub_pd(x1, x2), v1y = _mm_sub_pd(y1, y2);
+    const __m128d v2x = _mm_sub_pd(x3, x2), v2y = _mm_sub_pd(y3, y2);
+    const __m128d dot =
+        _mm_add_pd(_mm_mul_pd(v1x, v2x), _mm_mul_pd(v1y, v2y));
+    const __m128d cross = _mm_andnot_pd(
+        sign, _mm_sub_pd(_mm_mul_pd(v1x, v2y), _mm_mul_pd(v1y, v2x)));
+    const __m128d below = _mm_cmpge_pd(
+        _mm_add_pd(_mm_mul_pd(below_dot, dot), _mm_mul_pd(below_cross, cross)),
+        below_min);
+    const __m128d above = _mm_cmpge_pd(
+        _mm_add_pd(_mm_mul_pd(above_dot, dot), _mm_mul_pd(above_cross, cross)),
+        above_min);
+    // validAngle(): neither end point coincides with the vertex
+    const __m128d valid =
+        _mm_and_pd(_mm_or_pd(_mm_cmpneq_pd(x1, x2), _mm_cmpneq_pd(y1, y2)),
+                   _mm_or_pd(_mm_cmpneq_pd(x3, x2), _mm_cmpneq_pd(y3, y2)));
+    const int mask =
+        _mm_movemask_pd(_mm_and_pd(valid, _mm_or_pd(below, above)));
+    if (mask != 0)
+      return (mask & 1) ? i : i + 1;
+  }
+#endif
+
+  for (; i < windows; ++i) {
+    if (angleOutsideBounds(POINTS[i], POINTS[i + gap1],
+                           POINTS[i + gap1 + gap2], BOUNDS))
+      return i;
+  }
+  return -1;
+}
+
+int firstAngleOutside(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                      int gap2, const ANGLE_BOUNDS_T &BOUNDS) {
+  return AngleOutside<RUNTIME_GAP, RUNTIME_GAP>::scan(POINTS, NUMPOINTS, gap1,
+                                                     gap2, BOUNDS);
+}
+
+void quadrantCodes(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                   uint8_t *QUADRANTS) {
+  int i = 0;
+
+#if defined(__SSE2__)
+  const double *x = POINTS.x;
+  const double *y = POINTS.y;
+  const __m128d zero = _mm_setzero_pd();
+  for (; POINTS.stride == 1 && i + 2 <= NUMPOINTS; i += 2) {
+    // Bit l of left and below is the sign of lane l, see quadrant().
+    const int left = _mm_movemask_pd(lessMask(_mm_loadu_pd(x + i), zero));
+    const int below = _mm_movemask_pd(lessMask(_mm_loadu_pd(y + i), zero));
+    QUADRANTS[i] = (left & 1) ^ (3 * (below & 1));
+    QUADRANTS[i + 1] = (left >> 1) ^ (3 * (below >> 1));
+  }
+#endif
+
+  for (; i < NUMPOINTS; ++i) {
+    QUADRANTS[i] = quadrant(POINTS[i]);
+  }
+}
+
+int firstQuadrantWindow(const uint8_t *QUADRANTS, int NUMPOINTS, int Q_PTS,
+                        int QUADS) {
+  if (NUMPOINTS < Q_PTS)
+    return -1;
+  if (Q_PTS <= 0)
+    return 0 > QUADS ? 0 : -1;
+
+  QuadrantWindow window;
+  for (int j = 0; j < Q_PTS; ++j) {
+    window.add(QUADRANTS[j]);
+  }
+  for (int i = 0;; ++i) {
+    if (window.occupied > QUADS)
+      return i;
+    if (i + Q_PTS == NUMPOINTS)
+      return -1;
+    window.remove(QUADRANTS[i]);
+    window.add(QUADRANTS[i + Q_PTS]);
+  }
+}
+
+// *_PTS values for which gapKernels() selects kernels with compile-time gaps.
+// Each value adds one instantiation of the scans of one gap, and one per other
+// value of the scans of two, so the list should stay short.
+#ifndef DECIDE_GAP_PTS
+#define DECIDE_GAP_PTS 1, 2, 3, 4
+#endif
+
+template <int... PTS> struct GapList {};
+typedef GapList<DECIDE_GAP_PTS> COMMON_GAP_PTS;
+
+// KERNEL<PTS + 1>::scan if PTS is in the list, else KERNEL<RUNTIME_GAP>::scan.
+template <template <int> class KERNEL>
+static decltype(&KERNEL<RUNTIME_GAP>::scan) selectGap(GapList<>, int) {
+  return &KERNEL<RUNTIME_GAP>::scan;
+}
+
+template <template <int> class KERNEL, int FIRST, int... REST>
+static decltype(&KERNEL<RUNTIME_GAP>::scan) selectGap(GapList<FIRST, REST...>,
+                                                     int PTS) {
+  return PTS == FIRST ? &KERNEL<FIRST + 1>::scan
+                      : selectGap<KERNEL>(GapList<REST...>(), PTS);
+}
+
+// KERNEL<GAP1, PTS2 + 1>::scan if PTS2 is in the list, else the scan with
+// both gaps given at run time.
+template <template <int, int> class KERNEL, int GAP1>
+static decltype(&KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan)
+selectSecondGap(GapList<>, int) {
+  return &KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan;
+}
+
+template <template <int, int> class KERNEL, int GAP1, int FIRST, int... REST>
+static decltype(&KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan)
+selectSecondGap(GapList<FIRST, REST...>, int PTS2) {
+  return PTS2 == FIRST
+             ? &KERNEL<GAP1, FIRST + 1>::scan
+             : selectSecondGap<KERNEL, GAP1>(GapList<REST...>(), PTS2);
+}
+
+// KERNEL<PTS1 + 1, PTS2 + 1>::scan if both are in the list, else the scan
+// with both gaps given at run time.
+template <template <int, int> class KERNEL>
+static decltype(&KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan)
+selectGaps(GapList<>, int, int) {
+  return &KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan;
+}
+
+template <template <int, int> class KERNEL, int FIRST, int... REST>
+static decltype(&KERNEL<RUNTIME_GAP, RUNTIME_GAP>::scan)
+selectGaps(GapList<FIRST, REST...>, int PTS1, int PTS2) {
+  return PTS1 == FIRST
+             ? selectSecondGap<KERNEL, FIRST + 1>(COMMON_GAP_PTS(), PTS2)
+             : selectGaps<KERNEL>(GapList<REST...>(), PTS1, PTS2);
+}
+
+template <int GAP1, int GAP2> using AreaAbove = Area<true, GAP1, GAP2>;
+template <int GAP1, int GAP2> using AreaBelow = Area<false, GAP1, GAP2>;
+template <int GAP1, int GAP2> using RadiusAbove = Radius<true, GAP1, GAP2>;
+template <int GAP1, int GAP2> using RadiusWithin = Radius<false, GAP1, GAP2>;
+
+GAP_KERNELS_T gapKernels(const PARAMETERS_T &PARAMETERS) {
+  const PARAMETERS_T &P = PARAMETERS;
+  const COMMON_GAP_PTS common;
+  GAP_KERNELS_T kernels;
+  kernels.pair_at_least = selectGap<PairAtLeast>(common, P.K_PTS);
+  kernels.pair_at_most = selectGap<PairAtMost>(common, P.K_PTS);
+  kernels.radius_above = selectGaps<RadiusAbove>(common, P.A_PTS, P.B_PTS);
+  kernels.radius_within = selectGaps<RadiusWithin>(common, P.A_PTS, P.B_PTS);
+  kernels.angle_outside = selectGaps<AngleOutside>(common, P.C_PTS, P.D_PTS);
+  kernels.area_above = selectGaps<AreaAbove>(common, P.E_PTS, P.F_PTS);
+  kernels.area_below = selectGaps<AreaBelow>(common, P.E_PTS, P.F_PTS);
+  kernels.decrease = selectGap<Decrease>(common, P.G_PTS);
+  return kernels;
+}
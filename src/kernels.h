@@ -0,0 +1,194 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "points.h"
+#include <cstdint>
+
+struct PARAMETERS_T;
+
+// Vectorized scans over data points. Views of separate x and y arrays (stride
+// 1, see POINTS_SOA) take the SIMD path, other views a strided scalar loop.
+// They give the same answers as the scalar per-window tests in geometry.h, up
+// to rounding in the last bit for the distance scans. Thresholds are tested
+// with the lane masks of compare.h.
+
+/**
+ * @brief Thresholds of the angle test of LICs 2 and 9 for one EPSILON, see
+ * angleBounds().
+ *
+ * With v1 = point1 - point2 and v2 = point3 - point2, the angle t in [0, PI]
+ * at point2 has its cosine and sine in the ratio of dot = v1 . v2 to
+ * cross = |v1 x v2|. t is at most an angle a in [0, PI] exactly when
+ * sin(a - t) >= 0, that is when dot * sin(a) - cross * cos(a) >= 0, and at
+ * least a when cross * cos(a) - dot * sin(a) >= 0. Each half of the test is
+ * one such inequality, so it needs no sqrt, division or trigonometry.
+ */
+struct ANGLE_BOUNDS_T {
+  // LT to PI - EPSILON if below_dot * dot + below_cross * cross >= below_min
+  double below_dot;
+  double below_cross;
+  double below_min;
+  // GT to PI + EPSILON if above_dot * dot + above_cross * cross >= above_min
+  double above_dot;
+  double above_cross;
+  double above_min;
+};
+
+// Squared distance d^2 such that a distance d compares GT to LENGTH in
+// DOUBLECOMPARE exactly when d^2 is not less than it.
+double greaterThanSquared(double LENGTH);
+
+// Squared distance d^2 such that a distance d compares LT to LENGTH in
+// DOUBLECOMPARE exactly when d^2 is not greater than it. Negative if no
+// distance is LT to LENGTH.
+double lessThanSquared(double LENGTH);
+
+// Twice an area a, 2a, such that a compares GT to AREA in DOUBLECOMPARE
+// exactly when 2a is not less than it, see twiceAreaAtLeast().
+double greaterThanDoubled(double AREA);
+
+// Twice an area a, 2a, such that a compares LT to AREA in DOUBLECOMPARE
+// exactly when 2a is not greater than it, see twiceAreaAtMost(). Negative if
+// no area is LT to AREA.
+double lessThanDoubled(double AREA);
+
+/**
+ * @brief Returns true if some pair of points (i, i + gap), both among the
+ * first NUMPOINTS, is a distance greater than LENGTH apart (LICs 0, 7, 12).
+ * Same as anyPairAtLeast() with limit = greaterThanSquared(LENGTH).
+ */
+bool anyPairFarther(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double LENGTH);
+
+/**
+ * @brief Returns true if some pair of points (i, i + gap), both among the
+ * first NUMPOINTS, is a distance less than LENGTH apart (LIC 12).
+ * Same as anyPairAtMost() with limit = lessThanSquared(LENGTH).
+ */
+bool anyPairCloser(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                   double LENGTH);
+
+// Returns true if the squared distance of some pair of points (i, i + gap) is
+// not less than limit. A NaN distance counts.
+bool anyPairAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double limit);
+
+// Returns true if the squared distance of some pair of points (i, i + gap) is
+// not greater than limit. Never true for a negative limit.
+bool anyPairAtMost(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                   double limit);
+
+// The first i for which anyPairAtLeast() and anyPairAtMost() find their pair,
+// or -1 if there is none.
+int firstPairAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                     double limit);
+int firstPairAtMost(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                    double limit);
+
+/**
+ * @brief Returns true if some window of N_PTS consecutive points, among the
+ * first NUMPOINTS, has a point further than DIST from the line through the
+ * first and last point of the window, or from the first point if the two
+ * coincide (LIC 6).
+ *
+ * Compares the squared cross product against DIST^2 times the squared length
+ * of the line, so there is no division or sqrt per point, exactly as
+ * lic6Window() does: windows are handled two at a time, one per SIMD lane, and
+ * a lane whose values are too close to the threshold to trust goes to the
+ * exact predicates.
+ */
+bool anyWindowFarFromLine(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                          double DIST);
+
+// anyWindowFarFromLine() with the squared distance limit =
+// greaterThanSquared(DIST).
+bool anyWindowAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                      double limit);
+
+// The first window in which anyWindowAtLeast() finds a point, or -1.
+int firstWindowAtLeast(const POINTS_VIEW &POINTS, int NUMPOINTS, int N_PTS,
+                       double limit);
+
+// The first i for which the x coordinate decreases from point i to point
+// i + gap, lessWithTolerance(x[i + gap] - x[i], 0) (LICs 5, 11), or -1.
+int firstDecrease(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap);
+
+/**
+ * @brief The first i for which the triangle of points i, i + gap1 and
+ * i + gap1 + gap2 has an area greater than AREA (LICs 3, 10), or -1. Twice
+ * the area is compared with greaterThanDoubled(AREA) exactly, as by
+ * twiceAreaAtLeast(), two windows at a time with its filter per SIMD lane.
+ */
+int firstAreaAbove(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                   int gap2, double AREA);
+
+// Like firstAreaAbove(), for an area less than AREA (LIC 14), as by
+// twiceAreaAtMost() with lessThanDoubled(AREA).
+int firstAreaBelow(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                   int gap2, double AREA);
+
+// The first i for which points i, i + gap1 and i + gap1 + gap2 do not fit in a
+// circle of radius RADIUS (firstRadiusAbove, LICs 1 and 8) or do
+// (firstRadiusWithin, LIC 13), as by fitsInCircle(), or -1. Tests two windows
+// at a time, one per SIMD lane.
+int firstRadiusAbove(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                     int gap2, double RADIUS);
+int firstRadiusWithin(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                      int gap2, double RADIUS);
+
+/**
+ * @brief The first i for which points i, i + gap1 and i + gap1 + gap2 pass
+ * angleOutsideBounds() (LICs 2, 9), or -1. Tests two windows at a time, one
+ * per SIMD lane, from the dot and cross products of their legs.
+ */
+int firstAngleOutside(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                      int gap2, const ANGLE_BOUNDS_T &BOUNDS);
+
+// Writes quadrant() of each of the first NUMPOINTS points to QUADRANTS.
+void quadrantCodes(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                   uint8_t *QUADRANTS);
+
+/**
+ * @brief The first window of Q_PTS consecutive points, given by their
+ * quadrants, that lies in more than QUADS quadrants (LIC 4), or -1. Slides a
+ * QuadrantWindow over the points, O(NUMPOINTS) for any Q_PTS. An empty window
+ * (Q_PTS <= 0) covers no quadrants.
+ */
+int firstQuadrantWindow(const uint8_t *QUADRANTS, int NUMPOINTS, int Q_PTS,
+                        int QUADS);
+
+typedef int (*PAIR_SCAN_T)(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap,
+                           double limit);
+typedef int (*DECREASE_SCAN_T)(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                               int gap);
+typedef int (*TRIPLE_SCAN_T)(const POINTS_VIEW &POINTS, int NUMPOINTS,
+                             int gap1, int gap2, double LIMIT);
+typedef int (*ANGLE_SCAN_T)(const POINTS_VIEW &POINTS, int NUMPOINTS, int gap1,
+                            int gap2, const ANGLE_BOUNDS_T &BOUNDS);
+
+/**
+ * @brief The scans of LICs 7 to 14, each for the gaps of one set of
+ * parameters. They take the same arguments, and give the same answers, as the
+ * functions above, and are called with the gaps of those parameters.
+ */
+struct GAP_KERNELS_T {
+  PAIR_SCAN_T pair_at_least;   // firstPairAtLeast(), K_PTS + 1
+  PAIR_SCAN_T pair_at_most;    // firstPairAtMost(), K_PTS + 1
+  TRIPLE_SCAN_T radius_above;  // firstRadiusAbove(), A_PTS + 1, B_PTS + 1
+  TRIPLE_SCAN_T radius_within; // firstRadiusWithin(), A_PTS + 1, B_PTS + 1
+  ANGLE_SCAN_T angle_outside;  // firstAngleOutside(), C_PTS + 1, D_PTS + 1
+  TRIPLE_SCAN_T area_above;    // firstAreaAbove(), E_PTS + 1, F_PTS + 1
+  TRIPLE_SCAN_T area_below;    // firstAreaBelow(), E_PTS + 1, F_PTS + 1
+  DECREASE_SCAN_T decrease;    // firstDecrease(), G_PTS + 1
+};
+
+/**
+ * @brief Selects the kernels for the gaps of PARAMETERS. Each scan is
+ * instantiated with its gaps as compile-time constants for every combination
+ * of the *_PTS values in DECIDE_GAP_PTS (1, 2, 3 and 4 unless the build sets
+ * it), so that strides and offsets fold into the addressing. For other values
+ * the kernels are the functions above, which take the gaps at run time.
+ */
+GAP_KERNELS_T gapKernels(const PARAMETERS_T &PARAMETERS);
+
+#endif
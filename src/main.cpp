@@ -1,90 +1,180 @@
 #include "decide.h"
+#include "input.h"
+#include "instrument.h"
+#include "profile.h"
+#include "server.h"
+#include "thread_pool.h"
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
-int main(int argc, char *argv[]) {
-  // dummy values for testing
-  (void)argc;
-  if (argc != 2) {
-    std::cout << "Usage: " << argv[0] << " <paramfile>" << std::endl;
+// Converts a text input file to a binary frame.
+static int convert(const std::string &textFileName,
+                   const std::string &frameFileName) {
+  MappedFile textFile(textFileName);
+  if (!textFile.isOpen()) {
+    std::cout << "Could not open file " << textFileName << std::endl;
     return 1;
   }
-  std::string paramFileName = argv[1];
-  std::ifstream paramFile;
-  paramFile.open(paramFileName);
-  if (!paramFile.is_open()) {
-    std::cout << "Could not open file " << paramFileName << std::endl;
+  std::vector<COORDINATE> points;
+  CONFIG_T config;
+  std::string error;
+  if (!readTextInput(textFile.data(), textFile.size(), points, config,
+                     error)) {
+    std::cout << error << " in file " << textFileName << std::endl;
     return 1;
   }
 
-  int NUMPOINTS;
-  paramFile >> NUMPOINTS;
+  std::string frame = encodeFrame(points, config);
+  std::ofstream frameFile(frameFileName, std::ios::binary);
+  if (!frameFile.write(frame.data(), frame.size())) {
+    std::cout << "Could not write file " << frameFileName << std::endl;
+    return 1;
+  }
+  return 0;
+}
 
-  std::vector<COORDINATE> points;
-  for (int i = 0; i < NUMPOINTS; i++) {
-    COORDINATE point;
-    paramFile >> point.x;
-    paramFile >> point.y;
-    points.push_back(point);
+// Writes the instrumentation totals to a file, see instrument.h.
+static bool writeProbes(const std::string &fileName,
+                        void (*write)(std::ostream &)) {
+  if (fileName.empty())
+    return true;
+  std::ofstream file(fileName);
+  write(file);
+  if (!file) {
+    std::cout << "Could not write file " << fileName << std::endl;
+    return false;
   }
+  return true;
+}
 
-  PARAMETERS_T parameters;
-  paramFile >> parameters.LENGTH1;
-  paramFile >> parameters.RADIUS1;
-  paramFile >> parameters.EPSILON;
-  paramFile >> parameters.AREA1;
-  paramFile >> parameters.Q_PTS;
-  paramFile >> parameters.QUADS;
-  paramFile >> parameters.DIST;
-  paramFile >> parameters.N_PTS;
-  paramFile >> parameters.K_PTS;
-  paramFile >> parameters.A_PTS;
-  paramFile >> parameters.B_PTS;
-  paramFile >> parameters.C_PTS;
-  paramFile >> parameters.D_PTS;
-  paramFile >> parameters.E_PTS;
-  paramFile >> parameters.F_PTS;
-  paramFile >> parameters.G_PTS;
-  paramFile >> parameters.LENGTH2;
-  paramFile >> parameters.RADIUS2;
-  paramFile >> parameters.AREA2;
+// Loads the LIC profile saved in a file, if there is one yet.
+static bool readProfile(const std::string &fileName, LicProfile &profile) {
+  std::ifstream file(fileName);
+  if (!file.is_open())
+    return true;
+  if (!profile.load(file)) {
+    std::cout << "Invalid profile in file " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
 
-  std::array<std::array<CONNECTORS, 15>, 15> lcm;
+// Saves the LIC profile to a file.
+static bool writeProfile(const std::string &fileName,
+                         const LicProfile &profile) {
+  std::ofstream file(fileName);
+  profile.save(file);
+  if (!file) {
+    std::cout << "Could not write file " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  const std::string program = argc > 0 ? argv[0] : "decide";
+  if (argc == 4 && std::string(argv[1]) == "--convert") {
+    return convert(argv[2], argv[3]);
+  }
 
-  for (int i = 0; i < 15; i++) {
-    for (int j = 0; j < 15; j++) {
-      std::string temp;
-      paramFile >> temp;
-      if (temp == "ANDD") {
-        lcm[i][j] = ANDD;
-      } else if (temp == "ORR") {
-        lcm[i][j] = ORR;
-      } else if (temp == "NOTUSED") {
-        lcm[i][j] = NOTUSED;
-      } else {
-        std::cout << "Invalid connector in file " << paramFileName << std::endl;
-        return 1;
-      }
-    }
+  // --profile FILE keeps the order in which the server computes the LICs
+  // (see profile.h) in FILE: it is loaded from FILE if that exists, and
+  // saved back when a stream ends.
+  std::string profileFileName;
+  LicProfile profile;
+  if (argc >= 4 && std::string(argv[1]) == "--profile") {
+    profileFileName = argv[2];
+    if (!readProfile(profileFileName, profile))
+      return 1;
+    argv += 2;
+    argc -= 2;
   }
+  LicProfile *serverProfile = profileFileName.empty() ? nullptr : &profile;
 
-  std::array<bool, 15> puv;
-  for (int i = 0; i < 15; i++) {
-    std::string temp;
-    paramFile >> temp;
-    if (temp == "T") {
-      puv[i] = true;
-    } else if (temp == "F") {
-      puv[i] = false;
-    } else {
-      std::cout << temp << std::endl;
-      std::cout << "Invalid PUV in file " << paramFileName << std::endl;
+  // Answers a stream of requests on stdin, or on a UNIX domain socket, see
+  // server.h.
+  if (argc == 2 && std::string(argv[1]) == "--serve") {
+    const bool served = serveStream(0, 1, serverProfile);
+    if (serverProfile != nullptr && !writeProfile(profileFileName, profile))
       return 1;
-    }
+    return served ? 0 : 1;
+  }
+  if (argc == 3 && std::string(argv[1]) == "--serve") {
+    std::string error;
+    serveSocket(argv[2], error, serverProfile, profileFileName);
+    std::cout << "Could not serve on " << argv[2] << ": " << error
+              << std::endl;
+    return 1;
+  }
+
+  // -j THREADS evaluates the LICs in parallel. --metrics-json and
+  // --metrics-prom dump the counters of an instrumented build afterwards.
+  int threads = 0;
+  std::string jsonFileName;
+  std::string promFileName;
+  while (argc >= 4) {
+    const std::string option = argv[1];
+    if (option == "-j")
+      threads = std::atoi(argv[2]);
+    else if (option == "--metrics-json")
+      jsonFileName = argv[2];
+    else if (option == "--metrics-prom")
+      promFileName = argv[2];
+    else
+      break;
+    argv += 2;
+    argc -= 2;
+  }
+  if (argc != 2 || threads < 0 || !profileFileName.empty()) {
+    std::cout << "Usage: " << program
+              << " [-j THREADS] [--metrics-json FILE] [--metrics-prom FILE]"
+                 " <paramfile>\n"
+              << "       " << program << " --convert <paramfile> <framefile>\n"
+              << "       " << program
+              << " [--profile FILE] --serve [SOCKET]" << std::endl;
+    return 1;
+  }
+  std::string paramFileName = argv[1];
+  MappedFile paramFile(paramFileName);
+  if (!paramFile.isOpen()) {
+    std::cout << "Could not open file " << paramFileName << std::endl;
+    return 1;
   }
 
-  Decide decide(NUMPOINTS, points, parameters, lcm, puv);
-  decide.decide();
+  // Binary frames are evaluated in place, text files are parsed first.
+  int NUMPOINTS;
+  POINTS_VIEW view;
+  POINTS_SOA points;
+  CONFIG_T config;
+  std::string error;
+  bool valid;
+  if (isFrame(paramFile.data(), paramFile.size())) {
+    valid = decodeFrame(paramFile.data(), paramFile.size(), NUMPOINTS, view,
+                        config, error);
+  } else {
+    std::vector<COORDINATE> coordinates;
+    valid = readTextInput(paramFile.data(), paramFile.size(), coordinates,
+                          config, error);
+    points = POINTS_SOA(coordinates);
+    NUMPOINTS = points.size();
+    view = POINTS_VIEW(points);
+  }
+  if (!valid) {
+    std::cout << error << " in file " << paramFileName << std::endl;
+    return 1;
+  }
+
+  Decide decide(NUMPOINTS, view, config.PARAMETERS, config.LCM, config.PUV);
+  if (threads > 0) {
+    ThreadPool pool(threads);
+    decide.decide(pool);
+  } else {
+    decide.decide();
+  }
 
+  if (!writeProbes(jsonFileName, writeProbesJson) ||
+      !writeProbes(promFileName, writeProbesPrometheus))
+    return 1;
   return 0;
 }
@@ -0,0 +1,198 @@
+#include "parallel.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace {
+
+// The independent searches that make up the CMV. Parts 0 to 11 are LICs 0 to
+// 11; LICs 12, 13 and 14 reuse parts 7, 8 and 10 for their first condition.
+enum PART {
+  LIC12_LENGTH2 = 12, // pair separated by K_PTS closer than LENGTH2
+  LIC13_RADIUS2,      // triple that fits in a circle of radius RADIUS2
+  LIC14_AREA2,        // triple with an area less than AREA2
+  PART_COUNT
+};
+
+// Windows between two checks of whether another chunk found a window.
+const int CHECK_INTERVAL = 1024;
+
+struct Search {
+  const int NUMPOINTS;
+  const POINTS_VIEW C;
+  const PARAMETERS_T &P;
+  const ANGLE_BOUNDS_T ANGLE; // LICs 2 and 9
+  std::atomic<bool> found[PART_COUNT];
+
+  Search(int NUMPOINTS, const POINTS_VIEW &C, const PARAMETERS_T &P)
+      : NUMPOINTS(NUMPOINTS), C(C), P(P), ANGLE(angleBounds(P.EPSILON)) {
+    for (int part = 0; part < PART_COUNT; ++part) {
+      found[part] = false;
+    }
+  }
+
+  // Number of windows a part looks at, or 0 if its LIC is not met for
+  // NUMPOINTS points at all.
+  int windows(int part) const {
+    const int N = NUMPOINTS;
+    int count = 0;
+    switch (part) {
+    case 0:
+    case 5:
+      count = N - 1;
+      break;
+    case 1:
+    case 2:
+    case 3:
+      count = N - 2;
+      break;
+    case 4:
+      count = P.Q_PTS > 0 && N >= P.Q_PTS ? N - P.Q_PTS + 1 : 0;
+      break;
+    case 6:
+      count = N >= 3 && P.N_PTS >= 3 ? N - P.N_PTS + 1 : 0;
+      break;
+    case 7:
+    case LIC12_LENGTH2:
+      count = N >= 3 && P.K_PTS >= 0 ? N - P.K_PTS - 1 : 0;
+      break;
+    case 8:
+    case LIC13_RADIUS2:
+      count = N >= 5 && P.A_PTS >= 0 && P.B_PTS >= 0
+                  ? N - P.A_PTS - P.B_PTS - 2
+                  : 0;
+      break;
+    case 9:
+      count = N >= 5 && P.C_PTS >= 0 && P.D_PTS >= 0
+                  ? N - P.C_PTS - P.D_PTS - 2
+                  : 0;
+      break;
+    case 10:
+    case LIC14_AREA2:
+      count = N >= 5 && P.E_PTS >= 0 && P.F_PTS >= 0
+                  ? N - P.E_PTS - P.F_PTS - 2
+                  : 0;
+      break;
+    case 11:
+      count = N >= 3 && P.G_PTS >= 0 ? N - P.G_PTS - 1 : 0;
+      break;
+    }
+    return std::max(count, 0);
+  }
+
+  // Searches the windows starting in [begin, end) for one satisfying part.
+  bool scan(int part, int begin, int end) const {
+    switch (part) {
+    case 0:
+      return anyPairFarther(C.from(begin), end - begin + 1, 1, P.LENGTH1);
+    case 1:
+      return firstRadiusAbove(C.from(begin), end - begin + 2, 1, 1,
+                              P.RADIUS1) >= 0;
+    case 2:
+      return firstAngleOutside(C.from(begin), end - begin + 2, 1, 1, ANGLE) >=
+             0;
+    case 3:
+      return firstAreaAbove(C.from(begin), end - begin + 2, 1, 1, P.AREA1) >= 0;
+    case 4: {
+      QuadrantWindow quadrants;
+      for (int j = begin; j < begin + P.Q_PTS; ++j) {
+        quadrants.add(quadrant(C[j]));
+      }
+      for (int i = begin; i < end; ++i) {
+        if (quadrants.occupied > P.QUADS)
+          return true;
+        if (i + 1 < end) {
+          quadrants.remove(quadrant(C[i]));
+          quadrants.add(quadrant(C[i + P.Q_PTS]));
+        }
+      }
+      return false;
+    }
+    case 5:
+      return firstDecrease(C.from(begin), end - begin + 1, 1) >= 0;
+    case 6:
+      return anyWindowFarFromLine(C.from(begin), end - begin + P.N_PTS - 1,
+                                  P.N_PTS, P.DIST);
+    case 7:
+      return anyPairFarther(C.from(begin), end - begin + P.K_PTS + 1,
+                            P.K_PTS + 1, P.LENGTH1);
+    case 8:
+      return firstRadiusAbove(C.from(begin),
+                              end - begin + P.A_PTS + P.B_PTS + 2,
+                              P.A_PTS + 1, P.B_PTS + 1, P.RADIUS1) >= 0;
+    case LIC13_RADIUS2:
+      return firstRadiusWithin(C.from(begin),
+                               end - begin + P.A_PTS + P.B_PTS + 2,
+                               P.A_PTS + 1, P.B_PTS + 1, P.RADIUS2) >= 0;
+    case 9:
+      return firstAngleOutside(C.from(begin),
+                               end - begin + P.C_PTS + P.D_PTS + 2,
+                               P.C_PTS + 1, P.D_PTS + 1, ANGLE) >= 0;
+    case 10:
+      return firstAreaAbove(C.from(begin), end - begin + P.E_PTS + P.F_PTS + 2,
+                            P.E_PTS + 1, P.F_PTS + 1, P.AREA1) >= 0;
+    case LIC14_AREA2:
+      return firstAreaBelow(C.from(begin), end - begin + P.E_PTS + P.F_PTS + 2,
+                            P.E_PTS + 1, P.F_PTS + 1, P.AREA2) >= 0;
+    case 11:
+      return firstDecrease(C.from(begin), end - begin + P.G_PTS + 1,
+                           P.G_PTS + 1) >= 0;
+    case LIC12_LENGTH2:
+      return anyPairCloser(C.from(begin), end - begin + P.K_PTS + 1,
+                           P.K_PTS + 1, P.LENGTH2);
+    }
+    return false;
+  }
+
+  // Task body: scans one chunk, giving up once another chunk of the same part
+  // has found a window.
+  void scanChunk(int part, int begin, int end) {
+    for (int i = begin; i < end; i += CHECK_INTERVAL) {
+      if (found[part].load(std::memory_order_relaxed))
+        return;
+      if (scan(part, i, std::min(end, i + CHECK_INTERVAL))) {
+        found[part].store(true, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+};
+
+} // namespace
+
+std::array<bool, 15> parallelCMV(ThreadPool &POOL, int NUMPOINTS,
+                                 const POINTS_VIEW &COORDINATES,
+                                 const PARAMETERS_T &PARAMETERS, int CHUNK) {
+  const PARAMETERS_T &P = PARAMETERS;
+  // Shared by all tasks, and only released after POOL.wait() below.
+  std::unique_ptr<Search> search(new Search(NUMPOINTS, COORDINATES, P));
+  Search *s = search.get();
+
+  CHUNK = std::max(CHUNK, 1);
+  for (int part = 0; part < PART_COUNT; ++part) {
+    const int windows = s->windows(part);
+    // LIC 6 does N_PTS work per window.
+    const int chunk =
+        part == 6 ? std::max(CHUNK / std::max(P.N_PTS, 1), 1) : CHUNK;
+    for (int begin = 0; begin < windows; begin += chunk) {
+      const int end = std::min(windows, begin + chunk);
+      POOL.submit([s, part, begin, end] { s->scanChunk(part, begin, end); });
+    }
+  }
+  POOL.wait();
+
+  std::array<bool, 15> CMV;
+  for (int l = 0; l < 12; ++l) {
+    CMV[l] = s->found[l];
+  }
+  // An empty LIC 4 window covers no quadrants.
+  if (P.Q_PTS <= 0)
+    CMV[4] = NUMPOINTS >= P.Q_PTS && 0 > P.QUADS;
+  CMV[12] = CMV[7] && s->found[LIC12_LENGTH2];
+  CMV[13] = CMV[8] && s->found[LIC13_RADIUS2];
+  CMV[14] = CMV[10] && s->found[LIC14_AREA2];
+  return CMV;
+}
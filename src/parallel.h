@@ -0,0 +1,26 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "decide.h"
+
+class ThreadPool;
+
+/**
+ * @brief Computes the CMV on a thread pool.
+ *
+ * Every LIC, and each of the two conditions of LICs 12, 13 and 14, is an
+ * independent search for a window of points. Each search is split into
+ * chunks of at least CHUNK window starts, and all chunks of all searches are
+ * queued on POOL. As soon as a chunk finds a window, the remaining chunks of
+ * that search stop at their next check. Short tracks give one chunk per
+ * search, so that the LICs still run next to each other.
+ *
+ * Uses the same per-window tests as Decide::LicN(), so the CMV is exactly the
+ * one Decide::Calc_CMV() computes.
+ */
+std::array<bool, 15> parallelCMV(ThreadPool &POOL, int NUMPOINTS,
+                                 const POINTS_VIEW &COORDINATES,
+                                 const PARAMETERS_T &PARAMETERS,
+                                 int CHUNK = 8192);
+
+#endif
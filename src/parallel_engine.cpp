@@ -0,0 +1,66 @@
+#include "parallel_engine.h"
+#include "parallel.h"
+#include "thread_pool.h"
+#include <algorithm>
+
+ParallelEngine::ParallelEngine(ThreadPool &POOL, const CompiledConfig &CONFIG,
+                               int PACK, int SPLIT)
+    : POOL(POOL), CONFIG(CONFIG), PACK(std::max(PACK, 1)), SPLIT(SPLIT) {
+  for (int i = 0; i <= POOL.size(); ++i) {
+    engines.emplace_back(new DecideEngine(CONFIG));
+  }
+}
+
+void ParallelEngine::decideFrames(const FRAME_T *FRAMES, int BEGIN, int END,
+                                  DECISION_T *DECISIONS) {
+  DecideEngine &engine = *engines[POOL.worker()];
+  for (int f = BEGIN; f < END; ++f) {
+    if (FRAMES[f].NUMPOINTS <= SPLIT)
+      DECISIONS[f] = engine.evaluate(FRAMES[f].NUMPOINTS, FRAMES[f].POINTS);
+  }
+}
+
+void ParallelEngine::decideBatch(const FRAME_T *FRAMES, int COUNT,
+                                 DECISION_T *DECISIONS) {
+  // Work of the packed frames, and the task size that spreads it over enough
+  // tasks.
+  large.clear();
+  long long work = 0;
+  for (int f = 0; f < COUNT; ++f) {
+    if (FRAMES[f].NUMPOINTS > SPLIT)
+      large.push_back(f);
+    else
+      work += std::max(FRAMES[f].NUMPOINTS, 0) + FRAME_COST;
+  }
+  const long long tasks = (long long)TASKS_PER_THREAD * (POOL.size() + 1);
+  const long long pack = std::max(std::min((long long)PACK, work / tasks), 1LL);
+
+  int begin = 0;
+  long long packed = 0;
+  for (int f = 0; f < COUNT; ++f) {
+    if (FRAMES[f].NUMPOINTS <= SPLIT)
+      packed += std::max(FRAMES[f].NUMPOINTS, 0) + FRAME_COST;
+    if (packed >= pack || f + 1 == COUNT) {
+      const int end = f + 1;
+      if (packed > 0) {
+        POOL.submit([this, FRAMES, begin, end, DECISIONS] {
+          decideFrames(FRAMES, begin, end, DECISIONS);
+        });
+      }
+      begin = end;
+      packed = 0;
+    }
+  }
+  POOL.wait();
+
+  // Each large frame on all workers at once.
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  CMV_BITS_T bits;
+  bits.fill(0);
+  for (int f : large) {
+    DECISION_T &decision = DECISIONS[f];
+    decision.CMV = parallelCMV(POOL, FRAMES[f].NUMPOINTS, FRAMES[f].POINTS, P);
+    packCMV(decision.CMV, 0, bits);
+    decision.LAUNCH = CONFIG.launch.launch(bits) & 1;
+  }
+}
@@ -0,0 +1,67 @@
+#ifndef PARALLEL_ENGINE_H
+#define PARALLEL_ENGINE_H
+
+#include "engine.h"
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+// One frame of a batch, read in place: NUMPOINTS points from POINTS.
+struct FRAME_T {
+  int NUMPOINTS;
+  POINTS_VIEW POINTS;
+};
+
+/**
+ * @brief Evaluates batches of independent frames against one CompiledConfig,
+ * spread over the workers of a ThreadPool.
+ *
+ * decideBatch() packs consecutive frames into tasks of about PACK points, so
+ * that thousands of short frames do not cost a task each. If that would give
+ * fewer than TASKS_PER_THREAD tasks per thread, the tasks are made smaller,
+ * so that the pool still has some to steal when frames take uneven time.
+ * Every thread evaluates its frames with a DecideEngine of its own, kept from
+ * batch to batch, so evaluating a frame allocates nothing once the engines
+ * have seen a frame as long. Submitting a task does allocate, for its
+ * std::function and queue entry, but once per pack rather than per frame.
+ * Frames of more than SPLIT points are not packed. They are
+ * evaluated after the packed ones, one at a time, each split over all the
+ * workers by parallelCMV().
+ *
+ * Gives every frame the CMV and launch decision of DecideEngine::evaluate().
+ */
+class ParallelEngine {
+private:
+  ThreadPool &POOL;
+  const CompiledConfig CONFIG;
+  const int PACK;
+  const int SPLIT;
+
+  // One engine per worker of POOL, and one for the thread that calls
+  // decideBatch(), which works through tasks while it waits.
+  std::vector<std::unique_ptr<DecideEngine>> engines;
+
+  // Frames of the current batch with more than SPLIT points.
+  std::vector<int> large;
+
+  // Task body: evaluates the frames in [BEGIN, END) that are not large.
+  void decideFrames(const FRAME_T *FRAMES, int BEGIN, int END,
+                    DECISION_T *DECISIONS);
+
+public:
+  ParallelEngine(ThreadPool &POOL, const CompiledConfig &CONFIG,
+                 int PACK = 4096, int SPLIT = 65536);
+
+  // Writes the decision of FRAMES[f] to DECISIONS[f] for every f < COUNT. The
+  // points must stay alive and unchanged until it returns. Uses POOL for the
+  // whole call.
+  void decideBatch(const FRAME_T *FRAMES, int COUNT, DECISION_T *DECISIONS);
+
+  static const int TASKS_PER_THREAD = 4;
+
+  // Fixed cost of a frame, in points, when frames are packed.
+  static const int FRAME_COST = 32;
+};
+
+#endif
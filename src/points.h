@@ -0,0 +1,67 @@
+#ifndef POINTS_H
+#define POINTS_H
+
+#include <cstddef>
+#include <vector>
+
+struct COORDINATE {
+  double x;
+  double y;
+};
+
+/**
+ * @brief Data points stored as a structure of arrays, with all x coordinates
+ * in one array and all y coordinates in another. Kernels that walk the points
+ * at a fixed stride can then load several consecutive coordinates at once.
+ */
+struct POINTS_SOA {
+  std::vector<double> x;
+  std::vector<double> y;
+
+  POINTS_SOA() {}
+  explicit POINTS_SOA(const std::vector<COORDINATE> &POINTS)
+      : x(POINTS.size()), y(POINTS.size()) {
+    for (size_t i = 0; i < POINTS.size(); ++i) {
+      x[i] = POINTS[i].x;
+      y[i] = POINTS[i].y;
+    }
+  }
+
+  int size() const { return (int)x.size(); }
+};
+
+/**
+ * @brief Non-owning view of data points, where point i is
+ * (x[i * stride], y[i * stride]). Separate x and y arrays have stride 1, an
+ * array of COORDINATE has stride 2. The viewed memory must outlive the view.
+ */
+struct POINTS_VIEW {
+  const double *x;
+  const double *y;
+  int stride;
+
+  POINTS_VIEW() : x(nullptr), y(nullptr), stride(1) {}
+  POINTS_VIEW(const double *X, const double *Y) : x(X), y(Y), stride(1) {}
+  explicit POINTS_VIEW(const COORDINATE *POINTS)
+      : x(&POINTS->x), y(&POINTS->y), stride(2) {}
+  explicit POINTS_VIEW(const POINTS_SOA &POINTS)
+      : x(POINTS.x.data()), y(POINTS.y.data()), stride(1) {}
+
+  COORDINATE operator[](int i) const {
+    COORDINATE point = {x[i * stride], y[i * stride]};
+    return point;
+  }
+
+  // View of the points from point i onwards.
+  POINTS_VIEW from(int i) const {
+    POINTS_VIEW view = *this;
+    view.x += i * stride;
+    view.y += i * stride;
+    return view;
+  }
+};
+
+static_assert(sizeof(COORDINATE) == 2 * sizeof(double),
+              "POINTS_VIEW walks arrays of COORDINATE with a stride of 2");
+
+#endif
@@ -0,0 +1,154 @@
+#include "predicates.h"
+#include <cmath>
+
+namespace {
+
+// x + y = a + b exactly, with x = a + b rounded (Two-Sum).
+inline void twoSum(double a, double b, double &x, double &y) {
+  x = a + b;
+  const double b_virtual = x - a;
+  const double a_virtual = x - b_virtual;
+  y = (a - a_virtual) + (b - b_virtual);
+}
+
+// x + y = a * b exactly, with x = a * b rounded (Two-Product). Without a fused
+// multiply-add, the factors are split into halves whose products are exact.
+inline void twoProduct(double a, double b, double &x, double &y) {
+  x = a * b;
+#if defined(FP_FAST_FMA)
+  y = std::fma(a, b, -x);
+#else
+  const double SPLITTER = 134217729.0; // 2^27 + 1
+  const double ca = SPLITTER * a;
+  const double a_hi = ca - (ca - a);
+  const double a_lo = a - a_hi;
+  const double cb = SPLITTER * b;
+  const double b_hi = cb - (cb - b);
+  const double b_lo = b - b_hi;
+  y = a_lo * b_lo - (((x - a_hi * b_hi) - a_lo * b_hi) - a_hi * b_lo);
+#endif
+}
+
+// An exact sum of up to CAPACITY doubles, kept as a nonoverlapping expansion:
+// nonzero components in increasing order of magnitude, each smaller than the
+// lowest bit of the next. Its sign is that of its largest component.
+template <int CAPACITY> class Expansion {
+private:
+  double component[CAPACITY];
+  int size;
+
+public:
+  Expansion() : size(0) {}
+
+  // Adds b exactly (Grow-Expansion, dropping zero components). Every call
+  // adds at most one component.
+  void add(double b) {
+    double q = b;
+    int n = 0;
+    for (int i = 0; i < size; ++i) {
+      double sum, error;
+      twoSum(q, component[i], sum, error);
+      q = sum;
+      if (error != 0)
+        component[n++] = error;
+    }
+    if (q != 0)
+      component[n++] = q;
+    size = n;
+  }
+
+  // Adds a * b exactly, in two components.
+  void addProduct(double a, double b) {
+    double product, error;
+    twoProduct(a, b, product, error);
+    add(error);
+    add(product);
+  }
+
+  // Adds every component of E times factor, in 2 * E.count() components.
+  template <int OTHER>
+  void addProducts(const Expansion<OTHER> &E, double factor) {
+    for (int i = 0; i < E.count(); ++i)
+      addProduct(E[i], factor);
+  }
+
+  void negate() {
+    for (int i = 0; i < size; ++i)
+      component[i] = -component[i];
+  }
+
+  int count() const { return size; }
+  double operator[](int i) const { return component[i]; }
+  int sign() const {
+    return size == 0 ? 0 : component[size - 1] > 0 ? 1 : -1;
+  }
+};
+
+// a - b exactly, as part[1] = a - b rounded and part[0] its rounding error.
+struct Difference {
+  double part[2];
+  Difference(double a, double b) { twoSum(a, -b, part[1], part[0]); }
+};
+
+// Adds AX * BY - AY * BX of exact differences, in up to 16 components.
+template <int CAPACITY>
+void addCross(Expansion<CAPACITY> &value, const Difference &AX,
+              const Difference &AY, const Difference &BX,
+              const Difference &BY) {
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      value.addProduct(AX.part[i], BY.part[j]);
+      value.addProduct(-AY.part[i], BX.part[j]);
+    }
+  }
+}
+
+// Adds AX^2 + AY^2 of exact differences, in up to 16 components.
+template <int CAPACITY>
+void addSquaredLength(Expansion<CAPACITY> &value, const Difference &AX,
+                      const Difference &AY) {
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      value.addProduct(AX.part[i], AX.part[j]);
+      value.addProduct(AY.part[i], AY.part[j]);
+    }
+  }
+}
+
+} // namespace
+
+int exactTwiceAreaSign(const COORDINATE &p1, const COORDINATE &p2,
+                       const COORDINATE &p3, double LIMIT) {
+  Expansion<17> value;
+  addCross(value, Difference(p2.x, p1.x), Difference(p2.y, p1.y),
+           Difference(p3.x, p1.x), Difference(p3.y, p1.y));
+  if (value.sign() < 0)
+    value.negate();
+  value.add(-LIMIT);
+  return value.sign();
+}
+
+int exactLineDistanceSign(const COORDINATE &first, const COORDINATE &last,
+                          const COORDINATE &point, double LIMIT) {
+  const Difference dx(last.x, first.x), dy(last.y, first.y);
+  Expansion<16> c;
+  addCross(c, dx, dy, Difference(point.x, first.x),
+           Difference(point.y, first.y));
+  Expansion<16> length2;
+  addSquaredLength(length2, dx, dy);
+
+  Expansion<2 * 16 * 16 + 2 * 16> value;
+  for (int i = 0; i < c.count(); ++i)
+    value.addProducts(c, c[i]);
+  value.addProducts(length2, -LIMIT);
+  return value.sign();
+}
+
+int exactDistanceSign(const COORDINATE &first, const COORDINATE &point,
+                      double LIMIT) {
+  Expansion<17> value;
+  addSquaredLength(value, Difference(point.x, first.x),
+                   Difference(point.y, first.y));
+  value.add(-LIMIT);
+  return value.sign();
+}
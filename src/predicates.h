@@ -0,0 +1,33 @@
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include "points.h"
+
+/**
+ * @brief Exact signs of the polynomials in the coordinates that the area and
+ * distance tests of LICs 3, 6, 10 and 14 compare against their thresholds.
+ *
+ * The filters in geometry.h decide most windows in floating point, and call
+ * these only when the rounding error of the floating point value could have
+ * changed its sign. They compute with expansions, sums of doubles that are
+ * exact (Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast
+ * Robust Geometric Predicates", 1997), on the stack. Exact as long as no
+ * product of two coordinate differences overflows or underflows.
+ */
+
+// Sign (-1, 0 or 1) of |(p2 - p1) x (p3 - p1)| - LIMIT, twice the area of the
+// triangle against LIMIT.
+int exactTwiceAreaSign(const COORDINATE &p1, const COORDINATE &p2,
+                       const COORDINATE &p3, double LIMIT);
+
+// Sign of ((last - first) x (point - first))^2 - LIMIT * |last - first|^2,
+// the squared distance of point from the line through first and last, times
+// the squared length of the line, against LIMIT times the same.
+int exactLineDistanceSign(const COORDINATE &first, const COORDINATE &last,
+                          const COORDINATE &point, double LIMIT);
+
+// Sign of |point - first|^2 - LIMIT.
+int exactDistanceSign(const COORDINATE &first, const COORDINATE &point,
+                      double LIMIT);
+
+#endif
@@ -0,0 +1,82 @@
+#include "profile.h"
+#include <algorithm>
+#include <limits>
+
+// Decisiveness assumed for a LIC that has never decided LAUNCH, so that it
+// still gets ordered by cost.
+static const double MIN_DECISIVE = 0.001;
+
+LicProfile::LicProfile(double DECAY) : DECAY(DECAY) {
+  cost.fill(0);
+  decisive.fill(0);
+  samples.fill(0);
+}
+
+void LicProfile::record(int LIC, double NANOSECONDS, bool DECISIVE) {
+  const double d = DECISIVE ? 1 : 0;
+  if (samples[LIC] == 0) {
+    cost[LIC] = NANOSECONDS;
+    decisive[LIC] = d;
+  } else {
+    cost[LIC] += DECAY * (NANOSECONDS - cost[LIC]);
+    decisive[LIC] += DECAY * (d - decisive[LIC]);
+  }
+  ++samples[LIC];
+}
+
+std::array<int, 15>
+LicProfile::order(uint16_t NEEDED,
+                  const std::array<int, 15> &DEFAULT_ORDER) const {
+  // Sort keys: unmeasured needed LICs, then measured needed LICs by expected
+  // cost per decision, then LICs that are not needed.
+  std::array<double, 15> key;
+  for (int n = 0; n < 15; ++n) {
+    const int l = DEFAULT_ORDER[n];
+    if (!(NEEDED >> l & 1))
+      key[l] = std::numeric_limits<double>::infinity();
+    else if (samples[l] == 0)
+      key[l] = -1;
+    else
+      key[l] = cost[l] / std::max(decisive[l], MIN_DECISIVE);
+  }
+
+  // Stable insertion sort: std::stable_sort would allocate a buffer, and
+  // launch() does not allocate.
+  std::array<int, 15> order = DEFAULT_ORDER;
+  for (int n = 1; n < 15; ++n) {
+    const int l = order[n];
+    int m = n;
+    for (; m > 0 && key[l] < key[order[m - 1]]; --m)
+      order[m] = order[m - 1];
+    order[m] = l;
+  }
+  return order;
+}
+
+void LicProfile::save(std::ostream &OUT) const {
+  // All 17 significant digits, so that a loaded profile orders the LICs the
+  // same way.
+  const std::streamsize precision = OUT.precision(17);
+  for (int l = 0; l < 15; ++l) {
+    OUT << l << " " << samples[l] << " " << cost[l] << " " << decisive[l]
+        << "\n";
+  }
+  OUT.precision(precision);
+}
+
+bool LicProfile::load(std::istream &IN) {
+  std::array<double, 15> new_cost;
+  std::array<double, 15> new_decisive;
+  std::array<uint64_t, 15> new_samples;
+  for (int l = 0; l < 15; ++l) {
+    int lic;
+    if (!(IN >> lic >> new_samples[l] >> new_cost[l] >> new_decisive[l]) ||
+        lic != l || !(new_cost[l] >= 0) || !(new_decisive[l] >= 0) ||
+        new_decisive[l] > 1)
+      return false;
+  }
+  cost = new_cost;
+  decisive = new_decisive;
+  samples = new_samples;
+  return true;
+}
@@ -0,0 +1,57 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/**
+ * @brief Runtime profile of the LICs, used by DecideEngine::launch() to pick
+ * the order in which it computes CMV entries.
+ *
+ * For every LIC the profile keeps an exponentially decayed average of its
+ * cost and of how often its value alone decides LAUNCH. Computing the LICs by
+ * increasing cost / decisiveness minimizes the expected work until LAUNCH is
+ * known, if the LICs decide independently of each other.
+ *
+ * Not thread safe: share a profile between engines on one thread only.
+ */
+class LicProfile {
+private:
+  const double DECAY; // weight of a new sample
+
+  std::array<double, 15> cost;     // nanoseconds per computation
+  std::array<double, 15> decisive; // fraction of computations that decided
+  std::array<uint64_t, 15> samples;
+
+public:
+  // Each new sample gets weight DECAY in the averages, 0 < DECAY <= 1.
+  explicit LicProfile(double DECAY = 0.05);
+
+  // Records one computation of a LIC.
+  void record(int LIC, double NANOSECONDS, bool DECISIVE);
+
+  // Order for computing the LICs in NEEDED (bit i for LIC i), followed by the
+  // others. LICs without samples come first, in the order of DEFAULT_ORDER,
+  // so that each of them gets measured.
+  std::array<int, 15> order(uint16_t NEEDED,
+                            const std::array<int, 15> &DEFAULT_ORDER) const;
+
+  double averageCost(int LIC) const { return cost[LIC]; }
+  double decisiveness(int LIC) const { return decisive[LIC]; }
+  uint64_t sampleCount(int LIC) const { return samples[LIC]; }
+
+  /**
+   * @brief Writes the profile as text: one line per LIC with its number,
+   * sample count, average cost in nanoseconds and decisiveness, the averages
+   * with enough digits to load back unchanged.
+   */
+  void save(std::ostream &OUT) const;
+
+  // Reads a profile written by save(). Returns false, and leaves the profile
+  // unchanged, if the input is malformed.
+  bool load(std::istream &IN);
+};
+
+#endif
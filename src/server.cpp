@@ -0,0 +1,208 @@
+#include "server.h"
+#include "input.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Longest header line, and largest input, of a request.
+static const size_t MAX_HEADER = 80;
+static const size_t MAX_INPUT = (size_t)1 << 30;
+
+static bool blank(char c) { return c <= ' '; }
+
+FrameServer::FrameServer(LicProfile *PROFILE)
+    : profile(PROFILE), failed(false) {}
+
+void FrameServer::useConfig(const char *KEY, const CONFIG_T &CONFIG) {
+  if (engine && std::memcmp(key.data(), KEY, FRAME_CONFIG_SIZE) == 0)
+    return;
+  key.assign(KEY, FRAME_CONFIG_SIZE);
+  engine.reset(new DecideEngine(CompiledConfig(CONFIG)));
+  if (profile != nullptr)
+    engine->useProfile(profile);
+}
+
+void FrameServer::decide(const char *INPUT, size_t SIZE, std::string &OUT) {
+  CONFIG_T config;
+  std::string error;
+  bool launch;
+
+  if (isFrame(INPUT, SIZE)) {
+    // Binary frames are decided in place if their doubles are aligned.
+    const char *frame = INPUT;
+    if ((uintptr_t)INPUT % alignof(double) != 0) {
+      aligned.resize(SIZE / sizeof(double) + 1);
+      std::memcpy(aligned.data(), INPUT, SIZE);
+      frame = reinterpret_cast<const char *>(aligned.data());
+    }
+    int NUMPOINTS;
+    POINTS_VIEW view;
+    if (!decodeFrame(frame, SIZE, NUMPOINTS, view, config, error)) {
+      OUT += "ERROR " + error + "\n";
+      return;
+    }
+    useConfig(frame + FRAME_CONFIG_OFFSET, config);
+    launch = engine->launch(NUMPOINTS, view);
+  } else {
+    if (!readTextInput(INPUT, SIZE, points, config, error)) {
+      OUT += "ERROR " + error + "\n";
+      return;
+    }
+    char config_key[FRAME_CONFIG_SIZE];
+    encodeConfig(config, config_key);
+    useConfig(config_key, config);
+    launch = engine->launch(points);
+  }
+  OUT += launch ? "YES\n" : "NO\n";
+}
+
+size_t FrameServer::process(const char *DATA, size_t SIZE, std::string &OUT) {
+  size_t used = 0;
+  while (!failed && used < SIZE) {
+    const char *header = DATA + used;
+    const size_t available = SIZE - used;
+    const char *newline = static_cast<const char *>(
+        std::memchr(header, '\n', std::min(available, MAX_HEADER)));
+    if (newline == nullptr) {
+      if (available >= MAX_HEADER) {
+        OUT += "ERROR Header line too long\n";
+        failed = true;
+      }
+      break;
+    }
+
+    // <size> [<id>]
+    const char *c = header;
+    size_t size = 0;
+    for (; c < newline && *c >= '0' && *c <= '9' && size <= MAX_INPUT; ++c)
+      size = size * 10 + (*c - '0');
+    const char *id = newline;
+    bool valid = c > header && size <= MAX_INPUT;
+    if (c < newline) {
+      id = c + 1;
+      valid = valid && *c == ' ' && id < newline &&
+              std::find_if(id, newline, blank) == newline;
+    }
+    if (!valid) {
+      OUT += "ERROR Malformed header\n";
+      failed = true;
+      break;
+    }
+
+    const size_t header_size = newline + 1 - header;
+    if (available - header_size < size)
+      break;
+
+    if (id < newline) {
+      OUT.append(id, newline);
+      OUT += ' ';
+    }
+    decide(newline + 1, size, OUT);
+    used += header_size + size;
+  }
+  return used;
+}
+
+// Writes all of DATA, retrying after signals and short writes.
+static bool writeAll(int FD, const std::string &DATA) {
+  size_t written = 0;
+  while (written < DATA.size()) {
+    ssize_t n = write(FD, DATA.data() + written, DATA.size() - written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    written += n;
+  }
+  return true;
+}
+
+bool serveStream(int IN, int OUT, LicProfile *PROFILE) {
+  FrameServer server(PROFILE);
+  std::vector<char> buffer(1 << 16);
+  size_t begin = 0;
+  size_t end = 0;
+  std::string answers;
+
+  for (;;) {
+    begin += server.process(buffer.data() + begin, end - begin, answers);
+    // Everything read so far is answered, write it out before waiting for
+    // more input.
+    if (!writeAll(OUT, answers))
+      return false;
+    answers.clear();
+    if (server.broken())
+      return false;
+
+    // Keep the incomplete request at the front, and make room for it.
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    if (end == buffer.size())
+      buffer.resize(2 * buffer.size());
+
+    ssize_t n = read(IN, buffer.data() + end, buffer.size() - end);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return false;
+    if (n == 0) {
+      if (end == 0)
+        return true;
+      writeAll(OUT, "ERROR Incomplete request\n");
+      return false;
+    }
+    end += n;
+  }
+}
+
+bool serveSocket(const std::string &PATH, std::string &ERROR,
+                 LicProfile *PROFILE, const std::string &PROFILE_FILE) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof address);
+  address.sun_family = AF_UNIX;
+  if (PATH.size() >= sizeof address.sun_path) {
+    ERROR = "Socket path too long";
+    return false;
+  }
+  std::memcpy(address.sun_path, PATH.c_str(), PATH.size() + 1);
+
+  // A client that goes away must not end the server.
+  std::signal(SIGPIPE, SIG_IGN);
+
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) {
+    ERROR = std::strerror(errno);
+    return false;
+  }
+  unlink(PATH.c_str());
+  if (bind(listener, reinterpret_cast<sockaddr *>(&address),
+           sizeof address) < 0 ||
+      listen(listener, 16) < 0) {
+    ERROR = std::strerror(errno);
+    close(listener);
+    return false;
+  }
+
+  for (;;) {
+    int connection = accept(listener, nullptr, nullptr);
+    if (connection < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      ERROR = std::strerror(errno);
+      close(listener);
+      return false;
+    }
+    serveStream(connection, connection, PROFILE);
+    close(connection);
+    if (PROFILE != nullptr && !PROFILE_FILE.empty()) {
+      std::ofstream file(PROFILE_FILE);
+      PROFILE->save(file);
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "engine.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Decides a stream of requests with one warm engine.
+ *
+ * Every request is a header line with the size of its input and an optional
+ * id without whitespace, at most 80 bytes with the newline, followed by the
+ * input itself, either the text input of decide or a binary frame (see
+ * input.h):
+ *
+ *   <size> [<id>]\n<size bytes of input>
+ *
+ * Every request gets one line back, "YES", "NO" or "ERROR <description>",
+ * preceded by its id and a space if it had one. Consecutive requests with
+ * the same parameters, LCM and PUV share one CompiledConfig and DecideEngine.
+ * Given a LicProfile, every engine orders its LICs by it and adds to it.
+ */
+class FrameServer {
+private:
+  std::unique_ptr<DecideEngine> engine;
+  std::string key; // frame header bytes of the configuration of engine
+  LicProfile *profile;
+  bool failed;
+
+  std::vector<COORDINATE> points; // of text inputs
+  std::vector<double> aligned;    // copy of a misaligned binary frame
+
+  // Answers one input.
+  void decide(const char *INPUT, size_t SIZE, std::string &OUT);
+  // Makes engine the one for CONFIG, whose header bytes are KEY.
+  void useConfig(const char *KEY, const CONFIG_T &CONFIG);
+
+public:
+  // PROFILE, if not null, must outlive the server.
+  explicit FrameServer(LicProfile *PROFILE = nullptr);
+
+  /**
+   * @brief Answers the complete requests at the start of DATA, appending the
+   * lines to OUT, and returns the number of bytes they took. An incomplete
+   * request at the end is left for the next call, with more data.
+   *
+   * After a malformed header the stream cannot be followed any further: an
+   * error line is appended and broken() is true.
+   */
+  size_t process(const char *DATA, size_t SIZE, std::string &OUT);
+
+  bool broken() const { return failed; }
+};
+
+/**
+ * @brief Answers the requests read from the file descriptor IN on OUT, until
+ * IN ends, with a FrameServer on PROFILE. Answers are buffered, and written
+ * whenever the input read so far has been answered. Returns false on a read
+ * or write error, a malformed header, or a request cut short by the end of
+ * the input.
+ */
+bool serveStream(int IN, int OUT, LicProfile *PROFILE = nullptr);
+
+/**
+ * @brief Listens on a UNIX domain socket at PATH, replacing any file there,
+ * and serves its connections one after the other with serveStream(). If
+ * PROFILE_FILE is not empty, PROFILE is saved to it after every connection.
+ * Returns only if the socket cannot be set up, with the reason in ERROR.
+ */
+bool serveSocket(const std::string &PATH, std::string &ERROR,
+                 LicProfile *PROFILE = nullptr,
+                 const std::string &PROFILE_FILE = std::string());
+
+#endif
@@ -0,0 +1,103 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+// The pool and index of the worker running on this thread, if any.
+static thread_local const ThreadPool *current_pool = nullptr;
+static thread_local int current_worker = 0;
+
+ThreadPool::ThreadPool(int THREADS)
+    : queued(0), pending(0), next(0), stopping(false) {
+  if (THREADS <= 0)
+    THREADS = std::max(1u, std::thread::hardware_concurrency());
+  threads = THREADS;
+  queues.reset(new Queue[THREADS]);
+  for (int i = 0; i < THREADS; ++i) {
+    workers.emplace_back(&ThreadPool::work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  task_ready.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+int ThreadPool::worker() const {
+  return current_pool == this ? current_worker : size();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  const int self = worker();
+  Queue &queue = queues[self < size() ? self : next++ % size()];
+  ++pending;
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  ++queued;
+  // Taking the mutex orders the count before the check of a worker that is
+  // about to sleep, so the notification cannot get lost.
+  { std::lock_guard<std::mutex> lock(mutex); }
+  task_ready.notify_one();
+}
+
+bool ThreadPool::take(int WORKER, std::function<void()> &TASK) {
+  const int n = size();
+  for (int k = 0; k < n && queued > 0; ++k) {
+    const int q = (WORKER + k) % n;
+    Queue &queue = queues[q];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      continue;
+    if (q == WORKER) {
+      TASK = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      TASK = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --queued;
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::run(std::function<void()> &TASK) {
+  TASK();
+  TASK = nullptr;
+  if (--pending == 0) {
+    std::lock_guard<std::mutex> lock(mutex);
+    all_done.notify_all();
+  }
+}
+
+void ThreadPool::work(int WORKER) {
+  current_pool = this;
+  current_worker = WORKER;
+  std::function<void()> task;
+  while (true) {
+    if (take(WORKER, task)) {
+      run(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    task_ready.wait(lock, [this] { return stopping || queued > 0; });
+    if (stopping && queued == 0)
+      return;
+  }
+}
+
+void ThreadPool::wait() {
+  // Help with the queued tasks instead of only waiting for them.
+  std::function<void()> task;
+  while (take(worker(), task)) {
+    run(task);
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  all_done.wait(lock, [this] { return pending == 0; });
+}
@@ -0,0 +1,77 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads that run submitted tasks, with a queue
+ * per worker and work stealing between them.
+ *
+ * The workers live as long as the pool, so evaluations do not pay for thread
+ * creation. Tasks submitted from outside the pool are dealt to the queues in
+ * turn, and tasks a worker submits go to its own queue. A worker takes its
+ * newest task first, while it still is in cache, and once its queue is empty
+ * steals the oldest task of another, so that uneven tasks even out across the
+ * workers. wait() blocks until every submitted task has finished, running
+ * (stealing) queued tasks on the calling thread in the meantime. A pool
+ * serves one evaluation at a time.
+ */
+class ThreadPool {
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  // Set before the workers start, which read it while workers still grows.
+  int threads;
+  std::vector<std::thread> workers;
+  std::unique_ptr<Queue[]> queues; // one per worker
+  std::atomic<int> queued;         // tasks in the queues
+  std::atomic<int> pending;        // tasks submitted but not finished
+  std::atomic<unsigned> next;      // queue of the next outside submit()
+
+  // Idle workers and wait() sleep on these.
+  std::mutex mutex;
+  std::condition_variable task_ready;
+  std::condition_variable all_done;
+  bool stopping; // set by the destructor
+
+  void work(int WORKER);
+
+  // Takes a task for WORKER, from the back of its own queue or the front of
+  // another one, and returns false if every queue is empty.
+  bool take(int WORKER, std::function<void()> &TASK);
+
+  // Runs a task taken from a queue and counts it as finished.
+  void run(std::function<void()> &TASK);
+
+public:
+  // Starts THREADS workers, or one per hardware thread if THREADS <= 0.
+  explicit ThreadPool(int THREADS);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Number of worker threads.
+  int size() const { return threads; }
+
+  // Index of the calling thread among the workers of this pool, or size() for
+  // any other thread. Tasks can use it to pick per-thread state.
+  int worker() const;
+
+  void submit(std::function<void()> task);
+
+  // Waits until every task submitted so far has finished.
+  void wait();
+};
+
+#endif
@@ -0,0 +1,301 @@
+#include "typed_engine.h"
+#include "geometry.h"
+#include "kernels.h"
+#include <cmath>
+#include <limits>
+
+// Windows tested between two checks for an early exit.
+static const int BLOCK = 16;
+
+// Whether test(i) holds for some i in [0, COUNT). Tests BLOCK windows at a
+// time without branches, so that the compiler can vectorize the blocks.
+template <typename TEST> static bool anyWindow(int COUNT, TEST test) {
+  int i = 0;
+  for (; i + BLOCK <= COUNT; i += BLOCK) {
+    bool hit = false;
+    for (int j = i; j < i + BLOCK; ++j)
+      hit |= test(j);
+    if (hit)
+      return true;
+  }
+  for (; i < COUNT; ++i) {
+    if (test(i))
+      return true;
+  }
+  return false;
+}
+
+// Threshold conversions and tests, with tolerance for floating point WIDE
+// and exact for int64_t.
+
+// The least value of WIDE that is not less than LIMIT.
+template <typename WIDE> static WIDE roundUp(double LIMIT) {
+  return (WIDE)LIMIT;
+}
+
+// The greatest value of WIDE that is not greater than LIMIT, negative if
+// LIMIT is.
+template <typename WIDE> static WIDE roundDown(double LIMIT) {
+  return (WIDE)LIMIT;
+}
+
+// 2^63, beyond any value of an int64_t.
+static const double INT64_BEYOND = 9223372036854775808.0;
+
+template <> int64_t roundUp<int64_t>(double LIMIT) {
+  if (!(LIMIT < INT64_BEYOND))
+    return std::numeric_limits<int64_t>::max();
+  if (LIMIT < -INT64_BEYOND)
+    return std::numeric_limits<int64_t>::min();
+  return (int64_t)std::ceil(LIMIT);
+}
+
+template <> int64_t roundDown<int64_t>(double LIMIT) {
+  if (!(LIMIT < INT64_BEYOND))
+    return std::numeric_limits<int64_t>::max();
+  if (LIMIT < -INT64_BEYOND)
+    return std::numeric_limits<int64_t>::min();
+  return (int64_t)std::floor(LIMIT);
+}
+
+// Whether every coordinate is within the range in which WIDE holds the
+// derived values exactly. Floating point coordinates have no such range.
+template <typename T>
+static bool inRange(int NUMPOINTS, const T *X, const T *Y) {
+  (void)NUMPOINTS, (void)X, (void)Y;
+  return true;
+}
+
+template <>
+bool inRange<int32_t>(int NUMPOINTS, const int32_t *X, const int32_t *Y) {
+  const int32_t MAX = SCALAR_TRAITS<int32_t>::MAX_COORDINATE;
+  bool beyond = false;
+  for (int i = 0; i < NUMPOINTS; ++i) {
+    beyond |= (X[i] <= -MAX) | (X[i] >= MAX) | (Y[i] <= -MAX) | (Y[i] >= MAX);
+  }
+  return !beyond;
+}
+
+template <typename WIDE> static bool isNegative(WIDE VALUE) {
+  return lessWithTolerance(VALUE, 0);
+}
+
+template <> bool isNegative<int64_t>(int64_t VALUE) { return VALUE < 0; }
+
+template <typename WIDE> static bool isZero(WIDE VALUE) {
+  return std::fabs(VALUE) < COMPARE_EPSILON;
+}
+
+template <> bool isZero<int64_t>(int64_t VALUE) { return VALUE == 0; }
+
+// |CROSS| / sqrt(LENGTH2) >= sqrt(LIMIT), squared and multiplied out as in
+// anyWindowAtLeast().
+template <typename WIDE>
+static bool crossAtLeast(WIDE CROSS, WIDE LENGTH2, double LIMIT) {
+  return !(CROSS * CROSS < (WIDE)LIMIT * LENGTH2);
+}
+
+// The square of an exact cross product can overflow, so it is compared in
+// double.
+template <>
+bool crossAtLeast<int64_t>(int64_t CROSS, int64_t LENGTH2, double LIMIT) {
+  const double cross = (double)CROSS;
+  return !(cross * cross < LIMIT * (double)LENGTH2);
+}
+
+template <typename T>
+TypedEngine<T>::TypedEngine(const CompiledConfig &CONFIG) : CONFIG(CONFIG) {
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  length1_far = roundUp<WIDE>(CONFIG.length1_far);
+  length2_near = roundDown<WIDE>(CONFIG.length2_near);
+  dist_far = roundUp<WIDE>(CONFIG.dist_far);
+  area1_above = roundUp<WIDE>(greaterThanDoubled(P.AREA1));
+  area2_below = roundDown<WIDE>(lessThanDoubled(P.AREA2));
+
+  decision.LAUNCH = false;
+  decision.CMV.fill(false);
+  bits.fill(0);
+}
+
+template <typename T>
+bool TypedEngine<T>::lic(int LIC, int NUMPOINTS, const T *X, const T *Y) {
+  const bool EXACT = SCALAR_TRAITS<T>::EXACT;
+  const bool FILTERED = SCALAR_TRAITS<T>::FILTERED;
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  const int windows = CONFIG.windows(LIC, NUMPOINTS);
+  if (windows == 0)
+    return false;
+
+  // Points and their differences, in WIDE and in double.
+  auto dx = [X](int i, int j) { return (WIDE)X[j] - (WIDE)X[i]; };
+  auto dy = [Y](int i, int j) { return (WIDE)Y[j] - (WIDE)Y[i]; };
+  auto distance2 = [&](int i, int j) {
+    return dx(i, j) * dx(i, j) + dy(i, j) * dy(i, j);
+  };
+  auto point = [X, Y](int i) {
+    COORDINATE p = {(double)X[i], (double)Y[i]};
+    return p;
+  };
+  // Twice the area, term by term as in triangleArea(), against twice AREA1
+  // and AREA2.
+  auto twiceArea = [X, Y](int i, int j, int k) {
+    const WIDE x1 = X[i], y1 = Y[i], x2 = X[j], y2 = Y[j], x3 = X[k],
+               y3 = Y[k];
+    const WIDE area = x1 * (y2 - y3) + x2 * (y3 - y1) + x3 * (y1 - y2);
+    return area < 0 ? -area : area;
+  };
+  auto areaAbove = [&](int i, int j, int k) {
+    if (FILTERED)
+      return twiceAreaAtLeast(point(i), point(j), point(k), area1_above);
+    const WIDE area = twiceArea(i, j, k);
+    return EXACT ? area >= area1_above
+                 : greaterWithTolerance(0.5 * std::fabs((double)area), P.AREA1);
+  };
+  auto areaBelow = [&](int i, int j, int k) {
+    if (FILTERED)
+      return twiceAreaAtMost(point(i), point(j), point(k), area2_below);
+    const WIDE area = twiceArea(i, j, k);
+    return EXACT ? area <= area2_below
+                 : lessWithTolerance(0.5 * std::fabs((double)area), P.AREA2);
+  };
+
+  const int k = P.K_PTS + 1;
+  const int e = P.E_PTS + 1;
+  const int f = P.F_PTS + 1;
+  switch (LIC) {
+  case 0:
+    return anyWindow(windows, [&](int i) {
+      return !(distance2(i, i + 1) < length1_far);
+    });
+  case 1:
+    return anyWindow(windows, [&](int i) {
+      return !fitsInCircle(point(i), point(i + 1), point(i + 2),
+                           CONFIG.radius1_diameter2);
+    });
+  case 2:
+    return anyWindow(windows, [&](int i) {
+      return CONFIG.angleOutside(point(i), point(i + 1), point(i + 2));
+    });
+  case 3:
+    return anyWindow(windows, [&](int i) {
+      return areaAbove(i, i + 1, i + 2);
+    });
+  case 4: {
+    if ((int)quadrants.size() < NUMPOINTS)
+      quadrants.resize(NUMPOINTS);
+    for (int i = 0; i < NUMPOINTS; ++i) {
+      // As quadrant(), I = 0, II = 1, III = 2, IV = 3
+      const int left = isNegative<WIDE>(X[i]);
+      const int below = isNegative<WIDE>(Y[i]);
+      quadrants[i] = left ^ (3 * below);
+    }
+    return firstQuadrantWindow(quadrants.data(), NUMPOINTS, P.Q_PTS,
+                               P.QUADS) >= 0;
+  }
+  case 5:
+    return anyWindow(windows,
+                     [&](int i) { return isNegative(dx(i, i + 1)); });
+  case 6:
+    return anyWindow(windows, [&](int i) {
+      const int last = i + P.N_PTS - 1;
+      const WIDE line_x = dx(i, last);
+      const WIDE line_y = dy(i, last);
+      const bool coincident = isZero(line_x) && isZero(line_y);
+      const WIDE length2 = line_x * line_x + line_y * line_y;
+      for (int j = i + 1; j < last; ++j) {
+        if (FILTERED) {
+          const double sign =
+              coincident
+                  ? distanceSign(point(i), point(j), CONFIG.dist_far)
+                  : lineDistanceSign(point(i), point(last), point(j),
+                                     CONFIG.dist_far);
+          if (!(sign < 0))
+            return true;
+        } else if (coincident ? !(distance2(i, j) < dist_far)
+                              : crossAtLeast(line_x * dy(i, j) -
+                                                 dx(i, j) * line_y,
+                                             length2, CONFIG.dist_far)) {
+          return true;
+        }
+      }
+      return false;
+    });
+  case 7:
+    return anyWindow(windows, [&](int i) {
+      return !(distance2(i, i + k) < length1_far);
+    });
+  case 8:
+  case 13:
+    return anyWindow(windows, [&](int i) {
+      const bool fits = fitsInCircle(
+          point(i), point(i + P.A_PTS + 1), point(i + P.A_PTS + P.B_PTS + 2),
+          LIC == 8 ? CONFIG.radius1_diameter2 : CONFIG.radius2_diameter2);
+      return fits != (LIC == 8);
+    });
+  case 9:
+    return anyWindow(windows, [&](int i) {
+      return CONFIG.angleOutside(point(i), point(i + P.C_PTS + 1),
+                                 point(i + P.C_PTS + P.D_PTS + 2));
+    });
+  case 10:
+    return anyWindow(windows, [&](int i) {
+      return areaAbove(i, i + e, i + e + f);
+    });
+  case 11:
+    return anyWindow(windows, [&](int i) {
+      return isNegative(dx(i, i + P.G_PTS + 1));
+    });
+  case 12:
+    return anyWindow(windows, [&](int i) {
+      return distance2(i, i + k) <= length2_near;
+    });
+  case 14:
+    return anyWindow(windows, [&](int i) {
+      return areaBelow(i, i + e, i + e + f);
+    });
+  }
+  return false;
+}
+
+template <typename T>
+const DECISION_T &TypedEngine<T>::evaluate(int NUMPOINTS, const T *X,
+                                           const T *Y) {
+  if (!inRange(NUMPOINTS, X, Y))
+    return evaluateWide(NUMPOINTS, X, Y);
+
+  const PARAMETERS_T &P = CONFIG.CONFIG.PARAMETERS;
+  std::array<bool, 15> &CMV = decision.CMV;
+  for (int l = 0; l < 12; ++l) {
+    CMV[l] = lic(l, NUMPOINTS, X, Y);
+  }
+  if (P.Q_PTS <= 0)
+    CMV[4] = 0 > P.QUADS; // an empty window covers no quadrants
+  CMV[12] = CMV[7] && lic(12, NUMPOINTS, X, Y);
+  CMV[13] = CMV[8] && lic(13, NUMPOINTS, X, Y);
+  CMV[14] = CMV[10] && lic(14, NUMPOINTS, X, Y);
+
+  packCMV(CMV, 0, bits);
+  decision.LAUNCH = CONFIG.launch.launch(bits) & 1;
+  return decision;
+}
+
+template <typename T>
+const DECISION_T &TypedEngine<T>::evaluateWide(int NUMPOINTS, const T *X,
+                                               const T *Y) {
+  if (!wide_engine)
+    wide_engine.reset(new DecideEngine(CONFIG));
+  wide_points.x.assign(X, X + NUMPOINTS);
+  wide_points.y.assign(Y, Y + NUMPOINTS);
+  decision = wide_engine->evaluate(NUMPOINTS, POINTS_VIEW(wide_points));
+  return decision;
+}
+
+template <typename T>
+const DECISION_T &TypedEngine<T>::evaluate(const std::vector<T> &X,
+                                           const std::vector<T> &Y) {
+  return evaluate(X.size(), X.data(), Y.data());
+}
+
+template class TypedEngine<double>;
+template class TypedEngine<float>;
+template class TypedEngine<int32_t>;
@@ -0,0 +1,107 @@
+#ifndef TYPED_ENGINE_H
+#define TYPED_ENGINE_H
+
+#include "engine.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Arithmetic used by TypedEngine for coordinates of type T.
+ *
+ * WIDE holds differences, squared distances, cross products and twice the
+ * areas of triangles. For floating point coordinates it is the coordinate
+ * type itself, and thresholds are tested with the tolerances of compare.h. For
+ * integer coordinates it is a 64 bit integer, which holds all of these exactly
+ * as long as every coordinate is less than MAX_COORDINATE in magnitude. The
+ * thresholds are then rounded to integers once, and tested without tolerance.
+ * TypedEngine checks that bound on every frame.
+ * FILTERED types instead test areas and the distances of LIC 6 with the exact
+ * predicates of geometry.h, as DecideEngine does.
+ */
+template <typename T> struct SCALAR_TRAITS;
+
+template <> struct SCALAR_TRAITS<double> {
+  typedef double WIDE;
+  static const bool EXACT = false;
+  static const bool FILTERED = true;
+};
+
+template <> struct SCALAR_TRAITS<float> {
+  typedef float WIDE;
+  static const bool EXACT = false;
+  static const bool FILTERED = false;
+};
+
+template <> struct SCALAR_TRAITS<int32_t> {
+  typedef int64_t WIDE;
+  static const bool EXACT = true;
+  static const bool FILTERED = false;
+  static const int32_t MAX_COORDINATE = 1 << 30;
+};
+
+/**
+ * @brief Evaluates frames of coordinates of type T, given as separate x and y
+ * arrays, against one CompiledConfig.
+ *
+ * Instantiated for double, float and int32_t. TypedEngine<double> gives the
+ * same CMV and launch decision as DecideEngine. TypedEngine<float> computes
+ * in single precision, so it can differ where a value is within rounding of
+ * a threshold. TypedEngine<int32_t> computes squared distances, areas and
+ * cross products exactly, so its decisions for integer coordinates are the
+ * exact ones. A frame with a coordinate beyond MAX_COORDINATE is evaluated
+ * in double instead, by a DecideEngine.
+ *
+ * Distances, areas, x differences, quadrants and the distance test of LIC 6
+ * are computed in WIDE, in branch-free blocks that the compiler can vectorize
+ * at the width of T, except for the areas and LIC 6 of FILTERED types. The
+ * circles of LICs 1, 8 and 13 and the angles of LICs 2
+ * and 9 take products of up to six coordinates, and are tested in double as
+ * by DecideEngine.
+ */
+template <typename T> class TypedEngine {
+private:
+  typedef typename SCALAR_TRAITS<T>::WIDE WIDE;
+
+  const CompiledConfig CONFIG;
+  DECISION_T decision;
+  CMV_BITS_T bits;
+
+  // Thresholds of CONFIG in WIDE: a squared distance d2 meets LENGTH1 if
+  // !(d2 < length1_far), and so on. For EXACT and FILTERED types also twice
+  // the areas above AREA1 and below AREA2.
+  WIDE length1_far;
+  WIDE length2_near;
+  WIDE dist_far;
+  WIDE area1_above;
+  WIDE area2_below;
+
+  // Quadrant of every point for LIC 4, kept from frame to frame.
+  std::vector<uint8_t> quadrants;
+
+  // For frames beyond the range of WIDE: the points in double, and the engine
+  // that evaluates them, made on first use.
+  POINTS_SOA wide_points;
+  std::unique_ptr<DecideEngine> wide_engine;
+
+  // CMV and launch decision of a frame in double, by wide_engine.
+  const DECISION_T &evaluateWide(int NUMPOINTS, const T *X, const T *Y);
+
+  // Whether the frame meets a LIC. For LICs 12, 13 and 14 only their second
+  // condition; the first is the one of LICs 7, 8 and 10.
+  bool lic(int LIC, int NUMPOINTS, const T *X, const T *Y);
+
+public:
+  explicit TypedEngine(const CompiledConfig &CONFIG);
+
+  // CMV and launch decision of a frame. The reference stays valid until the
+  // next call.
+  const DECISION_T &evaluate(int NUMPOINTS, const T *X, const T *Y);
+  const DECISION_T &evaluate(const std::vector<T> &X, const std::vector<T> &Y);
+};
+
+extern template class TypedEngine<double>;
+extern template class TypedEngine<float>;
+extern template class TypedEngine<int32_t>;
+
+#endif
@@ -0,0 +1,157 @@
+#include "unlock.h"
+
+void calcPUM(const std::array<bool, 15> &CMV, const LCM_T &LCM, PUM_T &PUM) {
+  for (int x = 0; x < 15; ++x) {
+    for (int y = 0; y < 15; ++y) {
+      if (x == y) {
+        PUM[y][x] = true;
+        continue;
+      }
+
+      switch (LCM[y][x]) {
+      case ANDD:
+        PUM[y][x] = CMV[y] && CMV[x];
+        break;
+
+      case ORR:
+        PUM[y][x] = CMV[y] || CMV[x];
+        break;
+
+      default: // NOTUSED
+        PUM[y][x] = true;
+        break;
+      }
+    }
+  }
+}
+
+void calcFUV(const PUM_T &PUM, const std::array<bool, 15> &PUV,
+             std::array<bool, 15> &FUV) {
+  bool a;
+  for (int j = 0; j < 15; j++) {
+    a = PUM[0][j];
+    for (int i = 1; i < 15; i++) {
+      a &= PUM[i][j];
+    }
+    FUV[j] = (!PUV[j]) || a;
+  }
+}
+
+bool calcLAUNCH(const std::array<bool, 15> &FUV) {
+  bool LAUNCH = true;
+  for (int i = 0; i < 15; ++i) {
+    LAUNCH = LAUNCH && FUV[i];
+  }
+  return LAUNCH;
+}
+
+bool launchFromCMV(const std::array<bool, 15> &CMV, const LCM_T &LCM,
+                   const std::array<bool, 15> &PUV) {
+  PUM_T PUM;
+  std::array<bool, 15> FUV;
+  calcPUM(CMV, LCM, PUM);
+  calcFUV(PUM, PUV, FUV);
+  return calcLAUNCH(FUV);
+}
+
+void packCMV(const std::array<bool, 15> &CMV, int frame, CMV_BITS_T &BITS) {
+  const uint64_t bit = uint64_t(1) << frame;
+  for (int i = 0; i < 15; ++i) {
+    BITS[i] = CMV[i] ? (BITS[i] | bit) : (BITS[i] & ~bit);
+  }
+}
+
+std::array<bool, 15> unpackCMV(const CMV_BITS_T &BITS, int frame) {
+  std::array<bool, 15> CMV;
+  for (int i = 0; i < 15; ++i) {
+    CMV[i] = (BITS[i] >> frame) & 1;
+  }
+  return CMV;
+}
+
+BitslicedLaunch::BitslicedLaunch(const LCM_T &LCM,
+                                 const std::array<bool, 15> &PUV)
+    : LCM(LCM), PUV(PUV) {
+  for (int j = 0; j < 15; ++j) {
+    andd_rows[j] = orr_rows[j] = 0;
+    for (int y = 0; y < 15; ++y) {
+      if (y == j)
+        continue;
+      if (LCM[y][j] == ANDD)
+        andd_rows[j] |= 1 << y;
+      else if (LCM[y][j] == ORR)
+        orr_rows[j] |= 1 << y;
+    }
+  }
+}
+
+uint64_t BitslicedLaunch::fuv(const CMV_BITS_T &CMV, int j) const {
+  if (!PUV[j])
+    return ~uint64_t(0);
+
+  // AND over y of (CMV[y] && CMV[j]) is CMV[j] && (AND over y of CMV[y]).
+  uint64_t column = ~uint64_t(0);
+  if (andd_rows[j] != 0) {
+    column = CMV[j];
+    for (int y = 0; y < 15; ++y) {
+      if (andd_rows[j] >> y & 1)
+        column &= CMV[y];
+    }
+  }
+  for (int y = 0; y < 15; ++y) {
+    if (orr_rows[j] >> y & 1)
+      column &= CMV[y] | CMV[j];
+  }
+  return column;
+}
+
+uint64_t BitslicedLaunch::launch(const CMV_BITS_T &CMV) const {
+  uint64_t LAUNCH = ~uint64_t(0);
+  for (int j = 0; j < 15 && LAUNCH != 0; ++j) {
+    LAUNCH &= fuv(CMV, j);
+  }
+  return LAUNCH;
+}
+
+uint16_t BitslicedLaunch::needed() const {
+  uint16_t needed = 0;
+  for (int j = 0; j < 15; ++j) {
+    const uint16_t rows = andd_rows[j] | orr_rows[j];
+    if (PUV[j] && rows != 0)
+      needed |= rows | 1 << j;
+  }
+  return needed;
+}
+
+int BitslicedLaunch::partialLaunch(uint16_t KNOWN, uint16_t VALUE) const {
+  const uint16_t known_true = KNOWN & VALUE;
+  const uint16_t known_false = KNOWN & ~VALUE;
+  bool decided = true;
+  for (int j = 0; j < 15; ++j) {
+    if (!PUV[j])
+      continue;
+    const uint16_t self = 1 << j;
+    // ANDD entries need CMV[j] and every CMV[y]; ORR entries need CMV[j] or
+    // every CMV[y].
+    const uint16_t andd = andd_rows[j] != 0 ? andd_rows[j] | self : 0;
+    const uint16_t orr = (known_true & self) ? 0 : orr_rows[j];
+    if ((andd & known_false) != 0 ||
+        ((known_false & self) && (orr_rows[j] & known_false) != 0))
+      return 0;
+    if ((andd & ~known_true) != 0 || (orr & ~known_true) != 0)
+      decided = false;
+  }
+  return decided ? 1 : -1;
+}
+
+void BitslicedLaunch::pum(const CMV_BITS_T &CMV, int frame,
+                          PUM_T &PUM) const {
+  calcPUM(unpackCMV(CMV, frame), LCM, PUM);
+}
+
+void BitslicedLaunch::fuv(const CMV_BITS_T &CMV, int frame,
+                          std::array<bool, 15> &FUV) const {
+  for (int j = 0; j < 15; ++j) {
+    FUV[j] = (fuv(CMV, j) >> frame) & 1;
+  }
+}
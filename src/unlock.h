@@ -0,0 +1,78 @@
+#ifndef UNLOCK_H
+#define UNLOCK_H
+
+#include "decide.h"
+#include <cstdint>
+
+// Steps 2.2 - 2.4 of the specification as free functions, so that every
+// evaluator turns a CMV into a launch decision the same way Decide does.
+
+// Step 2.2: combine CMV entries as directed by the LCM.
+void calcPUM(const std::array<bool, 15> &CMV, const LCM_T &LCM, PUM_T &PUM);
+
+// Step 2.3: an entry of the FUV is true if it is not considered by the PUV,
+// or if all entries in its PUM column are true.
+void calcFUV(const PUM_T &PUM, const std::array<bool, 15> &PUV,
+             std::array<bool, 15> &FUV);
+
+// Step 2.4: launch if every entry of the FUV is true.
+bool calcLAUNCH(const std::array<bool, 15> &FUV);
+
+// Runs steps 2.2 - 2.4 on a CMV and returns the launch decision.
+bool launchFromCMV(const std::array<bool, 15> &CMV, const LCM_T &LCM,
+                   const std::array<bool, 15> &PUV);
+
+// CMVs of up to 64 frames, bit sliced: bit f of entry i is CMV[i] of frame f.
+typedef std::array<uint64_t, 15> CMV_BITS_T;
+
+// Stores the CMV of one frame as bit `frame` of each entry.
+void packCMV(const std::array<bool, 15> &CMV, int frame, CMV_BITS_T &BITS);
+
+// Returns the CMV of one frame.
+std::array<bool, 15> unpackCMV(const CMV_BITS_T &BITS, int frame);
+
+/**
+ * @brief Steps 2.2 - 2.4 for 64 frames at once, for frames that share the same
+ * LCM and PUV.
+ *
+ * The LCM and PUV are compiled once into, for every FUV entry that the PUV
+ * considers, the set of CMV entries it is ANDD-ed and ORR-ed with. A frame's
+ * CMV is then bit sliced across 15 words (see CMV_BITS_T), and the whole
+ * network of connectors runs as bitwise operations on those words, giving the
+ * launch decision of 64 frames in one pass.
+ */
+class BitslicedLaunch {
+private:
+  const LCM_T LCM;
+  const std::array<bool, 15> PUV;
+
+  // For FUV entry j: rows y whose connector with column j is ANDD / ORR.
+  std::array<uint16_t, 15> andd_rows;
+  std::array<uint16_t, 15> orr_rows;
+
+public:
+  BitslicedLaunch(const LCM_T &LCM, const std::array<bool, 15> &PUV);
+
+  // Bit f of the result is the FUV entry j of frame f.
+  uint64_t fuv(const CMV_BITS_T &CMV, int j) const;
+
+  // Bit f of the result is the launch decision of frame f. Bits of frames
+  // that were never packed have no meaning.
+  uint64_t launch(const CMV_BITS_T &CMV) const;
+
+  // CMV entries the launch decision can depend on, bit i for entry i. An
+  // entry is left out if the PUV does not consider any FUV entry whose PUM
+  // column combines it with another one.
+  uint16_t needed() const;
+
+  // Launch decision of a single frame of which only the CMV entries in KNOWN
+  // have been computed, with bit i of VALUE holding CMV[i]. Returns 1 or 0
+  // once the decision no longer depends on the other entries, -1 before.
+  int partialLaunch(uint16_t KNOWN, uint16_t VALUE) const;
+
+  // PUM and FUV of a single frame, computed on demand.
+  void pum(const CMV_BITS_T &CMV, int frame, PUM_T &PUM) const;
+  void fuv(const CMV_BITS_T &CMV, int frame, std::array<bool, 15> &FUV) const;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "batch.h"
+#include "decide.h"
+#include "incremental.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+
+// Test that every configuration of a batch gets the same CMV and launch
+// decision as when the points are evaluated for that configuration alone.
+TEST(BATCH, MATCHES_SINGLE_CONFIG) {
+  std::mt19937 rng(1337);
+
+  for (int track = 0; track < 20; ++track) {
+    std::vector<COORDINATE> points = randomPoints(rng, 5 + track * 7);
+    std::vector<CONFIG_T> configs;
+    for (int i = 0; i < 30; ++i) {
+      configs.push_back(randomConfig(rng));
+    }
+
+    BatchDecide batch(points.size(), points);
+    std::vector<DECISION_T> results = batch.evaluate(configs);
+    ASSERT_EQ(results.size(), configs.size());
+
+    for (size_t i = 0; i < configs.size(); ++i) {
+      IncrementalDecide single(configs[i].PARAMETERS, configs[i].LCM,
+                               configs[i].PUV);
+      single.append(points);
+      EXPECT_EQ(results[i].CMV, single.cmv());
+      EXPECT_EQ(results[i].LAUNCH, single.launch());
+    }
+  }
+}
+
+// Test that a batch gives the same answers for the example of LAUNCH_POSITIVE
+// as Decide, also when the configuration is repeated.
+TEST(BATCH, LAUNCH_POSITIVE) {
+  std::vector<COORDINATE> points = {{0, 0},  {100, 100}, {0, 0},  {20, 0},
+                                    {0, 20}, {0, 0},     {50, 0}, {100, 100}};
+
+  CONFIG_T config;
+  config.PARAMETERS = {100, 9.5, 0, 5, 0, 0, 10, 3, 0, 0,
+                       0,   0,   0, 1, 1, 0, 0,  0, 0};
+  for (auto &row : config.LCM)
+    row.fill(NOTUSED);
+  config.LCM[0].fill(ORR);
+  config.LCM[3].fill(ORR);
+  config.LCM[6].fill(ORR);
+  config.PUV.fill(false);
+  config.PUV[0] = config.PUV[3] = config.PUV[6] = true;
+
+  // Same profile, but with a LENGTH1 no pair of points is further apart than.
+  CONFIG_T negative = config;
+  negative.PARAMETERS.LENGTH1 = 1000;
+  negative.PARAMETERS.AREA1 = 10000;
+  negative.PARAMETERS.DIST = 1000;
+
+  BatchDecide batch(points.size(), points);
+  std::vector<DECISION_T> results = batch.evaluate({config, negative, config});
+
+  EXPECT_TRUE(results[0].LAUNCH);
+  EXPECT_TRUE(results[0].CMV[0]);
+  EXPECT_TRUE(results[0].CMV[3]);
+  EXPECT_TRUE(results[0].CMV[6]);
+  EXPECT_FALSE(results[1].LAUNCH);
+  EXPECT_TRUE(results[2].LAUNCH);
+}
+
+// Test that a batch agrees with deciding alone on areas and LIC 6 distances
+// on their thresholds and one unit either side, for points around a line
+// where plain floating point goes either way, see
+// PREDICATES.AREA_AND_LINE_AT_THRESHOLD. The triangle of points 0, 2 and 4
+// has twice the area 25 m |t|, and point 2 the distance 5 |t| from the line
+// through points 0 and 4.
+TEST(BATCH, AREA_AND_LINE_AT_THRESHOLD) {
+  const double first = 2147483648.0; // 2^31
+  const double m = 67108865.0;       // 2^26 + 1
+  std::mt19937 rng(29);
+
+  for (int k = 1; k < 20; ++k) {
+    for (int n = 0; n < 10; ++n) {
+      const double s = 134217728.0 + 7919 * n * k; // about 2^27
+      for (int jitter = -1; jitter <= 1; ++jitter) {
+        const double t = k + jitter;
+        const COORDINATE start = {first, first};
+        const COORDINATE point = {first + 3 * s - 4 * t, first + 4 * s + 3 * t};
+        const COORDINATE end = {first + 3 * m, first + 4 * m};
+        std::vector<COORDINATE> points = {start, start, point, start, end};
+
+        CONFIG_T config = randomConfig(rng);
+        PARAMETERS_T &p = config.PARAMETERS;
+        p.AREA1 = 12.5 * m * k - COMPARE_EPSILON;
+        p.AREA2 = 12.5 * m * k + COMPARE_EPSILON;
+        p.E_PTS = p.F_PTS = 1;
+        p.DIST = 5 * k - COMPARE_EPSILON;
+        p.N_PTS = 5;
+
+        BatchDecide batch(points.size(), points);
+        const DECISION_T result = batch.evaluate(config);
+        IncrementalDecide single(p, config.LCM, config.PUV);
+        single.append(points);
+        EXPECT_EQ(result.CMV, single.cmv()) << k << " " << jitter;
+      }
+    }
+  }
+}
@@ -16,7 +16,7 @@ TEST(CMV, LIC0_POSITIVE) {
        15} // Ensure distance between consecutive points is greater than LENGTH1
   };
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.LENGTH1 = 5.0; // LENGTH1 (assuming LENGTH1 is set to 5.0)
                             // other parameter values
 
@@ -44,7 +44,7 @@ TEST(CMV, LIC0_NEGATIVE) {
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
   std::array<bool, 15> puv;
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.LENGTH1 = 5.0;
 
   // Create Decide object with the provided points and parameters
@@ -64,7 +64,7 @@ TEST(CMV, LIC0_NEGATIVE) {
 TEST(CMV, LIC1_POSITIVE) {
   std::vector<COORDINATE> pointsP = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
 
-  PARAMETERS_T paramP;
+  PARAMETERS_T paramP = {};
   paramP.RADIUS1 = 0.5;
   std::array<std::array<CONNECTORS, 15>, 15> lcmP;
   std::array<bool, 15> puvP = {0};
@@ -81,7 +81,7 @@ TEST(CMV, LIC1_POSITIVE) {
 // Expected value FALSE
 TEST(CMV, LIC1_NEGATIVE) {
   std::vector<COORDINATE> pointsN = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
-  PARAMETERS_T paramN;
+  PARAMETERS_T paramN = {};
   paramN.RADIUS1 = 6;
   std::array<std::array<CONNECTORS, 15>, 15> lcmN;
   std::array<bool, 15> puvN;
@@ -98,7 +98,7 @@ TEST(CMV, LIC1_NEGATIVE) {
 // value FALSE
 TEST(CMV, LIC1_BOUNDRARY) {
   std::vector<COORDINATE> pointsB = {{0, 0}, {3, 0}, {0, 4}};
-  PARAMETERS_T paramB;
+  PARAMETERS_T paramB = {};
   paramB.RADIUS1 = 5.0;
 
   std::array<std::array<CONNECTORS, 15>, 15> lcmB;
@@ -109,6 +109,26 @@ TEST(CMV, LIC1_BOUNDRARY) {
   EXPECT_EQ(decideB.Lic1(), false);
 }
 
+// Collinear test case for LIC1(),
+// three points on a line fit in the circle that has the outer two as its
+// diameter, here of radius 1
+// Expected value FALSE, then TRUE for a smaller RADIUS1
+TEST(CMV, LIC1_COLLINEAR) {
+  std::vector<COORDINATE> points = {{0, 0}, {1, 0}, {2, 0}};
+  PARAMETERS_T parameters = {};
+  parameters.RADIUS1 = 1.5;
+
+  std::array<std::array<CONNECTORS, 15>, 15> lcm;
+  std::array<bool, 15> puv;
+
+  Decide fits(points.size(), points, parameters, lcm, puv);
+  EXPECT_EQ(fits.Lic1(), false);
+
+  parameters.RADIUS1 = 0.9;
+  Decide outside(points.size(), points, parameters, lcm, puv);
+  EXPECT_EQ(outside.Lic1(), true);
+}
+
 // Positive test for LIC2(),
 // Test that it can calculate an angle formed by three consecutive points
 // where point two is the vertex, that is less than PI + EPSILON
@@ -118,7 +138,7 @@ TEST(CMV, LIC2_POSITIVE) {
   std::vector<COORDINATE> points = {{0, 1}, {1, 0}, {1, 2}};
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.EPSILON = 0.1; // condition should be pi - 1 = ~2.14
   // 2.14 > 0.785 => CONDITION MET
   int numpoints = points.size();
@@ -142,7 +162,7 @@ TEST(CMV, LIC2_NEGATIVE_BAD_ANGLE) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.EPSILON = 0.1;
   // dummy variables
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
@@ -162,7 +182,7 @@ TEST(CMV, LIC3_POSITIVE) {
   std::vector<COORDINATE> points = {{0, 0}, {0, 1}, {1, 0}};
   int numpoints = points.size();
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.AREA1 = 0.4;
 
   // these variables dont matter for this test
@@ -184,7 +204,7 @@ TEST(CMV, LIC3_NEGATIVE) {
 
   int numpoints = points.size();
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.AREA1 = 0.6;
 
   // these variables dont matter for this test
@@ -206,7 +226,7 @@ TEST(CMV, LIC3_BOUNDRARY) {
 
   int numpoints = points.size();
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.AREA1 = 0.5;
 
   // these variables dont matter for this test
@@ -226,7 +246,7 @@ TEST(CMV, LIC4_POSITIVE) {
   // these points will result in 2 different quadrants being covered
   std::vector<COORDINATE> points2 = {{0, 0}, {-1, 1}, {-2, 2}};
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.Q_PTS = 3;
   parameters.QUADS = 1; // we check that more than 1 quadrant is covered =>
                         // 2 > 1 => CONDITION MET
@@ -246,7 +266,7 @@ TEST(CMV, LIC4_NEGATIVE) {
   // all points are in quadrant I
   std::vector<COORDINATE> points = {{0, 0}, {1, 1}, {2, 2}};
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.Q_PTS = 3;
   parameters.QUADS = 1; // 1 == 1 => CONDITION REJECTED
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
@@ -274,7 +294,7 @@ TEST(CMV, LIC5_POSITIVE) {
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
   std::array<bool, 15> puv;
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
 
   Decide decide(points.size(), points, parameters, lcm, puv);
 
@@ -296,7 +316,7 @@ TEST(CMV, LIC5_NEGATIVE) {
       {3, 3} // Ensure X[j] - X[i] >= 0 for all pairs of consecutive points
   };
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
   std::array<bool, 15> puv;
   // Create Decide object with the provided points
@@ -313,7 +333,7 @@ TEST(CMV, LIC5_NEGATIVE) {
 TEST(CMV, LIC6_POSITIVE) {
   std::vector<COORDINATE> pointsP = {{0, 0}, {3, 0}, {12, 4}, {3, 4}, {9, 10}};
   // create parameters container
-  PARAMETERS_T paramP;
+  PARAMETERS_T paramP = {};
   paramP.DIST = 0.5;
   paramP.N_PTS = 3;
   // dummy variables
@@ -333,7 +353,7 @@ TEST(CMV, LIC6_NEGATIVE) {
   // distance=0
   // create parameters container
 
-  PARAMETERS_T paramN;
+  PARAMETERS_T paramN = {};
   paramN.DIST = 50;
   paramN.N_PTS = 3;
   // dummy variables
@@ -352,7 +372,7 @@ TEST(CMV, LIC6_BOUNDRARY) {
   std::vector<COORDINATE> pointsB = {{0, 0}, {3, 0}, {0, 4}, {3, 4}, {3, 4}};
   //
   // create parameters container
-  PARAMETERS_T paramB;
+  PARAMETERS_T paramB = {};
   paramB.DIST = 5;
   paramB.N_PTS = 3;
   // dummy variables
@@ -364,6 +384,40 @@ TEST(CMV, LIC6_BOUNDRARY) {
   EXPECT_EQ(decideB.Lic6(), false);
 }
 
+// Test that LIC6 only measures the points inside each window of N_PTS points,
+// (10, 10) is far from the line y = 0 but is never inside a window on it.
+// Expected value FALSE
+TEST(CMV, LIC6_OUTSIDE_WINDOW) {
+  std::vector<COORDINATE> points = {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {10, 10}};
+  PARAMETERS_T parameters = {};
+  parameters.DIST = 1;
+  parameters.N_PTS = 3;
+  // dummy variables
+  std::array<std::array<CONNECTORS, 15>, 15> lcm;
+  std::array<bool, 15> puv;
+
+  Decide decide(points.size(), points, parameters, lcm, puv);
+
+  EXPECT_EQ(decide.Lic6(), false);
+}
+
+// Test that when the first and last point of a window coincide, LIC6 uses the
+// distance to that point instead of a line
+// Expected value TRUE
+TEST(CMV, LIC6_COINCIDENT) {
+  std::vector<COORDINATE> points = {{1, 1}, {1, 6}, {1, 1}};
+  PARAMETERS_T parameters = {};
+  parameters.DIST = 4;
+  parameters.N_PTS = 3;
+  // dummy variables
+  std::array<std::array<CONNECTORS, 15>, 15> lcm;
+  std::array<bool, 15> puv;
+
+  Decide decide(points.size(), points, parameters, lcm, puv);
+
+  EXPECT_EQ(decide.Lic6(), true);
+}
+
 // Positive test case for LIC7(),
 // Test that LIC7 can find two points seperated by K_PTS points apart
 // and have a greater length between them than LENGTH1
@@ -374,7 +428,7 @@ TEST(CMV, LIC7_POSITIVE) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.K_PTS = 2;
   parameters.LENGTH1 = 1.5;
   // dummy variables
@@ -401,7 +455,7 @@ TEST(CMV, LIC7_NEGATIVE_LENGHT1) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.K_PTS = 2;
   parameters.LENGTH1 = 1.5;
   // dummy variables
@@ -422,7 +476,7 @@ TEST(CMV, LIC7_NEGATIVE_NUMPOINTS) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   // dummy variables
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
   std::array<bool, 15> puv;
@@ -442,7 +496,7 @@ TEST(CMV, LIC8_POSITIVE) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 1;
@@ -466,7 +520,7 @@ TEST(CMV, LIC8_NEGATIVE) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 100;
@@ -491,7 +545,7 @@ TEST(CMV, LIC8_BOUNDRARY) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 0.5 * sqrt(2.0);
@@ -504,6 +558,29 @@ TEST(CMV, LIC8_BOUNDRARY) {
   EXPECT_EQ(d.Lic8(), false);
 }
 
+// Obtuse test case for LIC8(),
+// the triangle {0,0},{4,0},{2,1} has a circumradius of 1.25, but its longest
+// side of 4 does not fit in a circle of radius 1.5
+// Expected value TRUE
+TEST(CMV, LIC8_OBTUSE) {
+  std::vector<COORDINATE> points = {{0, 0}, {0, 0}, {0, 0}, {4, 0},
+                                    {0, 0}, {0, 0}, {2, 1}};
+
+  int numpoints = points.size();
+  PARAMETERS_T parameters = {};
+  parameters.A_PTS = 2;
+  parameters.B_PTS = 2;
+  parameters.RADIUS1 = 1.5;
+
+  // these variables dont matter for this test
+  std::array<std::array<CONNECTORS, 15>, 15> lcm;
+  std::array<bool, 15> puv;
+
+  Decide d(numpoints, points, parameters, lcm, puv);
+
+  EXPECT_EQ(d.Lic8(), true);
+}
+
 // Positive test case for LIC9(),
 // Tests that LIC9 can reject when points the angle is small
 // Expected value TRUE
@@ -511,7 +588,7 @@ TEST(CMV, LIC9_POSITIVE) {
   std::vector<COORDINATE> points = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {-1, 1}};
   // angle=PI/4<PI-2
   //  create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.D_PTS = 1;
   parameters.C_PTS = 1;
   parameters.EPSILON = 2;
@@ -531,7 +608,7 @@ TEST(CMV, LIC9_NEGATIVE) {
   std::vector<COORDINATE> points = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {2, 1}};
   // PI>angle=3PI/4>PI-2
   //  create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.D_PTS = 1;
   parameters.C_PTS = 1;
   parameters.EPSILON = 2;
@@ -643,7 +720,7 @@ TEST(CMV, LIC10_NEGATIVE) {
 TEST(CMV, LIC11_POSITIVE) {
   std::vector<COORDINATE> pointsP = {{5, 0}, {3, 0}, {4, 4}};
   // create parameters container
-  PARAMETERS_T paramP;
+  PARAMETERS_T paramP = {};
   paramP.G_PTS = 1;
   // these variables dont matter for this test
   std::array<std::array<CONNECTORS, 15>, 15> lcmP; //= {NOTUSED};
@@ -660,7 +737,7 @@ TEST(CMV, LIC11_POSITIVE) {
 TEST(CMV, LIC11_NEGATIVE) {
   std::vector<COORDINATE> pointsN = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
   // create parameters container
-  PARAMETERS_T paramN;
+  PARAMETERS_T paramN = {};
   paramN.G_PTS = 3;
   // these variables dont matter for this test
   std::array<std::array<CONNECTORS, 15>, 15> lcmN;
@@ -677,7 +754,7 @@ TEST(CMV, LIC11_NEGATIVE) {
 TEST(CMV, LIC11_BOUNDRARY) {
   std::vector<COORDINATE> pointsB = {{0, 0}, {3, 0}, {0, 4}};
   // create parameters container
-  PARAMETERS_T paramB;
+  PARAMETERS_T paramB = {};
   paramB.G_PTS = 1;
   // these variables dont matter for this test
   std::array<std::array<CONNECTORS, 15>, 15> lcmB;
@@ -698,7 +775,7 @@ TEST(CMV, LIC12_POSITIVE) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.K_PTS = 2;
   parameters.LENGTH1 = 4.8; // 0.1 and 5.1 >= 5
   parameters.LENGTH2 = 1.6; // 0.1 and 1.0 <= 1.5
@@ -720,7 +797,7 @@ TEST(CMV, LIC12_NEGATIVE_NUMPOINTS) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   // dummy parameters
   std::array<std::array<CONNECTORS, 15>, 15> lcm;
   std::array<bool, 15> puv;
@@ -742,7 +819,7 @@ TEST(CMV, LIC12_NEGATIVE_LENGHT1) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.K_PTS = 2;
   parameters.LENGTH1 = 5; // should be equal and fail
   parameters.LENGTH2 = 4;
@@ -767,7 +844,7 @@ TEST(CMV, LIC12_NEGATIVE_LENGHT2) {
   int numpoints = points.size();
 
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.K_PTS = 2;
   parameters.LENGTH1 = 22;
   parameters.LENGTH2 = 1;
@@ -791,7 +868,7 @@ TEST(CMV, LIC13_POSITIVE) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 1.0;
@@ -817,7 +894,7 @@ TEST(CMV, LIC13_NEGATIVE) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 100.0;
@@ -844,7 +921,7 @@ TEST(CMV, LIC13_BOUNDRARY) {
 
   int numpoints = points.size();
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.A_PTS = 2;
   parameters.B_PTS = 2;
   parameters.RADIUS1 = 1.0;
@@ -867,7 +944,7 @@ TEST(CMV, LIC14_POSITIVE) {
                                     {4, 0}, {8, 0}, {5, 5}};
   // area=12,12
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.E_PTS = 1;
   parameters.F_PTS = 1;
   parameters.AREA1 = 7;
@@ -888,7 +965,7 @@ TEST(CMV, LIC14_NEGATIVE) {
   std::vector<COORDINATE> points = {{0, 0}, {0, 4}, {4, 4}, {4, 0}, {1, 0}};
   // area=2
   // create parameters container
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
   parameters.E_PTS = 1;
   parameters.F_PTS = 1;
   parameters.AREA1 = 6;
@@ -1087,7 +1164,7 @@ TEST(LAUNCH, LAUNCH_POSITIVE3) {
 
   std::array<bool, 15> puv = {true};
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
 
   Decide decide(points.size(), points, parameters, lcm, puv);
 
@@ -1143,7 +1220,7 @@ TEST(LAUNCH, LAUNCH_NEGATIVE2) {
 
   std::array<bool, 15> puv = {true};
 
-  PARAMETERS_T parameters;
+  PARAMETERS_T parameters = {};
 
   Decide decide(points.size(), points, parameters, lcm, puv);
 
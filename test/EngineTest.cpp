@@ -0,0 +1,108 @@
+#include "decide.h"
+#include "engine.h"
+#include "geometry.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+
+// Test that one engine per configuration, given frame after frame, computes
+// the CMV and launch decision of a new Decide for each frame.
+TEST(ENGINE, MATCHES_DECIDE) {
+  std::mt19937 rng(12);
+
+  for (int run = 0; run < 50; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    DecideEngine engine{CompiledConfig(config)};
+
+    for (int frame = 0; frame < 20; ++frame) {
+      std::vector<COORDINATE> points = randomPoints(rng, frame * 3 % 40);
+      Decide decide(points.size(), points, config.PARAMETERS, config.LCM,
+                    config.PUV);
+      decide.Calc_CMV();
+      decide.Calc_PUM();
+      decide.Calc_FUV();
+      decide.Calc_LAUNCH();
+
+      const DECISION_T &decision = engine.evaluate(points);
+      EXPECT_EQ(decision.CMV, decide.CMV);
+      EXPECT_EQ(decision.LAUNCH, decide.LAUNCH);
+    }
+  }
+}
+
+// Test that the dot and cross product bounds give the same answer as
+// angleOutsidePi(), including for EPSILON at and beyond the ends of its range,
+// and where right and half right angles of grid points are on a bound.
+TEST(ENGINE, ANGLE_BOUNDS) {
+  std::mt19937 rng(13);
+  CONFIG_T config = randomConfig(rng);
+
+  for (double epsilon : {0.0, 0.0000001, 0.5, 2.0, PI - 0.0000001, PI, -0.1,
+                         3.5, PI / 4, PI / 2, 3 * PI / 4}) {
+    config.PARAMETERS.EPSILON = epsilon;
+    CompiledConfig compiled(config);
+    for (int run = 0; run < 500; ++run) {
+      std::vector<COORDINATE> p = randomPoints(rng, 3);
+      EXPECT_EQ(compiled.angleOutside(p[0], p[1], p[2]),
+                angleOutsidePi(p[0], p[1], p[2], epsilon));
+    }
+  }
+}
+
+// Test that lazy evaluation gives the launch decision of full evaluation, and
+// that the CMV entries it did compute are right.
+TEST(ENGINE, LAZY_MATCHES_FULL) {
+  std::mt19937 rng(14);
+
+  for (int run = 0; run < 200; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    // Some runs with a PUV that considers every entry, so that LAUNCH is
+    // often decided early.
+    if (run % 3 == 0)
+      config.PUV.fill(true);
+    DecideEngine full{CompiledConfig(config)};
+    DecideEngine lazy{CompiledConfig(config)};
+
+    for (int frame = 0; frame < 5; ++frame) {
+      std::vector<COORDINATE> points = randomPoints(rng, 5 + frame * 7);
+      const DECISION_T &expected = full.evaluate(points);
+      const bool launch = lazy.launch(points);
+      EXPECT_EQ(launch, expected.LAUNCH);
+      EXPECT_EQ(full.computedEntries(), (1 << 15) - 1);
+
+      const uint16_t computed = lazy.computedEntries();
+      for (int l = 0; l < 15; ++l) {
+        if (computed >> l & 1) {
+          EXPECT_EQ(lazy.lastDecision().CMV[l], expected.CMV[l]) << l;
+        } else {
+          EXPECT_FALSE(lazy.lastDecision().CMV[l]) << l;
+        }
+      }
+    }
+  }
+}
+
+// Test which CMV entries the launch decision depends on.
+TEST(ENGINE, NEEDED_ENTRIES) {
+  CONFIG_T config;
+  for (auto &row : config.LCM) {
+    row.fill(NOTUSED);
+  }
+  config.PUV.fill(false);
+  EXPECT_EQ(BitslicedLaunch(config.LCM, config.PUV).needed(), 0);
+
+  // FUV[3] combines CMV[3] with CMV[5] and CMV[9]. Row 7 is only used by
+  // FUV[12], which the PUV does not consider.
+  config.LCM[5][3] = config.LCM[3][5] = ANDD;
+  config.LCM[9][3] = config.LCM[3][9] = ORR;
+  config.LCM[7][12] = config.LCM[12][7] = ORR;
+  config.PUV[3] = true;
+  BitslicedLaunch launch(config.LCM, config.PUV);
+  EXPECT_EQ(launch.needed(), (1 << 3) | (1 << 5) | (1 << 9));
+
+  // CMV[5] false decides NO on its own. CMV[3] and CMV[5] true decide YES,
+  // whatever CMV[9] is.
+  EXPECT_EQ(launch.partialLaunch(0, 0), -1);
+  EXPECT_EQ(launch.partialLaunch(1 << 5, 0), 0);
+  EXPECT_EQ(launch.partialLaunch(1 << 3, 1 << 3), -1);
+  EXPECT_EQ(launch.partialLaunch(1 << 3 | 1 << 5, 1 << 3 | 1 << 5), 1);
+}
@@ -0,0 +1,73 @@
+#include "frame_cache.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+
+// Test that the cached arrays hold what the kernels compute from the points,
+// and that the cached scans find the same first pair as the kernels, one
+// frame after another with the same cache. Tracks are long enough to take
+// several chunks, and scans run both before and after the arrays are filled.
+TEST(FRAME_CACHE, MATCHES_KERNELS) {
+  std::mt19937 rng(18);
+  std::uniform_real_distribution<double> length(0, 10);
+  FrameCache cache;
+
+  for (int run = 0; run < 100; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 1 + run * 13 % 700);
+    POINTS_SOA soa(points);
+    const int n = soa.size();
+    const POINTS_VIEW view =
+        run % 2 ? POINTS_VIEW(soa) : POINTS_VIEW(points.data());
+    const double far = greaterThanSquared(length(rng));
+    const double near = lessThanSquared(length(rng));
+    cache.reset(n, view);
+    ASSERT_EQ(cache.size(), n);
+
+    for (int gap : {1, 1 + run % 7, 3}) {
+      EXPECT_EQ(cache.firstDistanceAtLeast(gap, far),
+                firstPairAtLeast(view, n, gap, far));
+      EXPECT_EQ(cache.firstDecrease(gap), firstDecrease(view, n, gap));
+
+      ASSERT_EQ(cache.pairs(gap), std::max(n - gap, 0));
+      const double *dx = cache.dx(gap);
+      const double *dy = cache.dy(gap);
+      const double *distance2 = cache.distance2(gap);
+      for (int i = 0; i < cache.pairs(gap); ++i) {
+        EXPECT_EQ(dx[i], points[i + gap].x - points[i].x);
+        EXPECT_EQ(dy[i], points[i + gap].y - points[i].y);
+        EXPECT_EQ(distance2[i], dx[i] * dx[i] + dy[i] * dy[i]);
+      }
+      EXPECT_EQ(cache.firstDistanceAtMost(gap, near),
+                firstPairAtMost(view, n, gap, near));
+    }
+
+    std::vector<uint8_t> quadrants(n);
+    quadrantCodes(view, n, quadrants.data());
+    EXPECT_EQ(std::vector<uint8_t>(cache.quadrants(), cache.quadrants() + n),
+              quadrants);
+  }
+}
+
+// Test that a cache reuses its storage for a frame no longer than the ones
+// before, and does not return the derived data of the previous frame.
+TEST(FRAME_CACHE, REUSES_STORAGE) {
+  std::vector<COORDINATE> first = {{0, 0}, {1, 1}, {3, 0}, {2, -2}};
+  std::vector<COORDINATE> second = {{0, 0}, {-1, 2}, {-4, -1}};
+  FrameCache cache(first.size(), POINTS_VIEW(first.data()));
+
+  const double *dx = cache.dx(1);
+  const uint8_t *quadrants = cache.quadrants();
+  EXPECT_EQ(dx[2], -1);
+  EXPECT_EQ(quadrants[3], 3);
+
+  cache.reset(second.size(), POINTS_VIEW(second.data()));
+  EXPECT_EQ(cache.dx(1), dx);
+  EXPECT_EQ(cache.quadrants(), quadrants);
+  EXPECT_EQ(dx[0], -1);
+  EXPECT_EQ(dx[1], -3);
+  EXPECT_EQ(quadrants[2], 2);
+  EXPECT_EQ(cache.firstDecrease(1), 0);
+  EXPECT_EQ(cache.pairs(3), 0);
+  EXPECT_EQ(cache.firstDistanceAtLeast(3, 0), -1);
+}
@@ -0,0 +1,48 @@
+#include "decide.h"
+#include "fused.h"
+#include "incremental.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+
+// Test that the fused single pass gives the same CMV as evaluating each LIC
+// on its own, for random tracks.
+TEST(FUSED, MATCHES_DECIDE) {
+  std::mt19937 rng(99);
+
+  for (int run = 0; run < 300; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 1 + run % 40);
+    PARAMETERS_T parameters = randomParameters(rng);
+
+    IncrementalDecide incremental(parameters, LCM_T(), std::array<bool, 15>());
+    incremental.append(points);
+
+    EXPECT_EQ(fusedCMV(points.size(), points, parameters), incremental.cmv());
+  }
+}
+
+// Test tracks spanning several tiles where every LIC only finds its witness
+// in the last few points: a slow, straight, rightward track followed by a
+// sharp turn.
+TEST(FUSED, WITNESS_IN_LAST_TILE) {
+  std::mt19937 rng(100);
+
+  for (int run = 0; run < 50; ++run) {
+    int NUMPOINTS = 3 * FUSED_TILE + run * 11;
+    std::vector<COORDINATE> points;
+    for (int i = 0; i < NUMPOINTS - 4; ++i) {
+      points.push_back({i * 0.01, 1});
+    }
+    points.push_back({-20, -30});
+    points.push_back({15, 10});
+    points.push_back({-9, 6});
+    points.push_back({40, -2});
+
+    PARAMETERS_T parameters = randomParameters(rng);
+    parameters.QUADS = 1 + run % 3;
+
+    IncrementalDecide incremental(parameters, LCM_T(), std::array<bool, 15>());
+    incremental.append(points);
+
+    EXPECT_EQ(fusedCMV(points.size(), points, parameters), incremental.cmv());
+  }
+}
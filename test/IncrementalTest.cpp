@@ -0,0 +1,140 @@
+#include "decide.h"
+#include "incremental.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+#include <cmath>
+
+// Test that after every appended point, the CMV of the incremental engine is
+// the one Decide computes for the whole track so far. Tracks are longer than
+// the internal buffer so that compaction of old points is covered too.
+TEST(INCREMENTAL, MATCHES_DECIDE) {
+  std::mt19937 rng(2480);
+
+  LCM_T lcm;
+  for (auto &row : lcm)
+    row.fill(NOTUSED);
+  std::array<bool, 15> puv;
+  puv.fill(false);
+
+  for (int run = 0; run < 40; ++run) {
+    PARAMETERS_T parameters = randomParameters(rng);
+    IncrementalDecide incremental(parameters, lcm, puv);
+    std::vector<COORDINATE> track = randomPoints(rng, 150);
+    std::vector<COORDINATE> points;
+
+    for (const COORDINATE &point : track) {
+      points.push_back(point);
+      incremental.append(point);
+      if (points.size() < 3)
+        continue;
+
+      Decide decide(points.size(), points, parameters, lcm, puv);
+      std::array<bool, 15> cmv = incremental.cmv();
+      EXPECT_EQ(cmv[0], decide.Lic0());
+      EXPECT_EQ(cmv[1], decide.Lic1());
+      EXPECT_EQ(cmv[2], decide.Lic2());
+      EXPECT_EQ(cmv[3], decide.Lic3());
+      EXPECT_EQ(cmv[4], decide.Lic4());
+      EXPECT_EQ(cmv[5], decide.Lic5());
+      EXPECT_EQ(cmv[6], decide.Lic6());
+      EXPECT_EQ(cmv[7], decide.Lic7());
+      EXPECT_EQ(cmv[8], decide.Lic8());
+      EXPECT_EQ(cmv[9], decide.Lic9());
+      EXPECT_EQ(cmv[10], decide.Lic10());
+      EXPECT_EQ(cmv[11], decide.Lic11());
+      EXPECT_EQ(cmv[12], decide.Lic12());
+      EXPECT_EQ(cmv[13], decide.Lic13());
+      EXPECT_EQ(cmv[14], decide.Lic14());
+    }
+  }
+}
+
+// LIC 6 only looks at the N_PTS points of each window.
+TEST(INCREMENTAL, LIC6_WINDOW) {
+  PARAMETERS_T parameters = {};
+  parameters.DIST = 1;
+  parameters.N_PTS = 3;
+  LCM_T lcm = {};
+  std::array<bool, 15> puv = {false};
+
+  IncrementalDecide incremental(parameters, lcm, puv);
+  incremental.append({{0, 0}, {1, 0}, {2, 0}, {3, 0}});
+  EXPECT_FALSE(incremental.cmv()[6]);
+
+  // (4, 3) is 3 away from the line through (3, 0) and (5, 0)
+  incremental.append({{4, 3}, {5, 0}});
+  EXPECT_TRUE(incremental.cmv()[6]);
+
+  incremental.reset();
+  EXPECT_EQ(incremental.numpoints(), 0);
+  EXPECT_FALSE(incremental.cmv()[6]);
+}
+
+// Test LICs 0, 7 and 12 on distances a few ulps around the tolerance bound
+// LENGTH1 + COMPARE_EPSILON, which is also LENGTH2 - COMPARE_EPSILON, and at
+// LENGTH1 +- 1e-7, where a distance and its square can compare differently.
+TEST(INCREMENTAL, DISTANCE_AT_TOLERANCE) {
+  LCM_T lcm;
+  for (auto &row : lcm)
+    row.fill(NOTUSED);
+  std::array<bool, 15> puv;
+  puv.fill(false);
+
+  for (double length : {0.3, 1.0, 7.0, 1234.5}) {
+    PARAMETERS_T parameters = {};
+    parameters.LENGTH1 = length;
+    parameters.LENGTH2 = length + 2 * COMPARE_EPSILON;
+    parameters.K_PTS = 1;
+    IncrementalDecide incremental(parameters, lcm, puv);
+
+    for (double bound : {length + COMPARE_EPSILON, length - 1e-7,
+                         length + 1e-7}) {
+      double distance = bound;
+      for (int step = 0; step < 40; ++step)
+        distance = std::nextafter(distance, 0.0);
+      for (int step = 0; step < 80; ++step) {
+        distance = std::nextafter(distance, 2 * bound);
+        // Points 0 and 1, and 0 and 2, are distance apart.
+        const COORDINATE far = {0.6 * distance, 0.8 * distance};
+        const std::vector<COORDINATE> points = {{0, 0}, far, far};
+        Decide decide(points.size(), points, parameters, lcm, puv);
+        incremental.reset();
+        incremental.append(points);
+        const std::array<bool, 15> cmv = incremental.cmv();
+        EXPECT_EQ(cmv[0], decide.Lic0()) << distance;
+        EXPECT_EQ(cmv[7], decide.Lic7()) << distance;
+        EXPECT_EQ(cmv[12], decide.Lic12()) << distance;
+      }
+    }
+  }
+}
+
+// Test that the launch decision is the same as for Decide, when fed the points
+// of LAUNCH_POSITIVE one at a time.
+TEST(INCREMENTAL, LAUNCH_POSITIVE) {
+  std::vector<COORDINATE> points = {{0, 0},  {100, 100}, {0, 0},  {20, 0},
+                                    {0, 20}, {0, 0},     {50, 0}, {100, 100}};
+
+  PARAMETERS_T parameters = {100, 9.5, 0, 5, 0, 0, 10, 3, 0, 0,
+                             0,   0,   0, 1, 1, 0, 0,  0, 0};
+
+  LCM_T lcm;
+  for (auto &row : lcm)
+    row.fill(NOTUSED);
+  lcm[0].fill(ORR);
+  lcm[3].fill(ORR);
+  lcm[6].fill(ORR);
+
+  std::array<bool, 15> puv = {false};
+  puv[0] = puv[3] = puv[6] = true;
+
+  IncrementalDecide incremental(parameters, lcm, puv);
+  incremental.append(points[0]);
+  incremental.append(points[1]);
+  EXPECT_FALSE(incremental.launch());
+
+  for (size_t i = 2; i < points.size(); ++i) {
+    incremental.append(points[i]);
+  }
+  EXPECT_TRUE(incremental.launch());
+}
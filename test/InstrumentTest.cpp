@@ -0,0 +1,62 @@
+#include "decide.h"
+#include "instrument.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+#include <sstream>
+
+// Test that an instrumented build counts calls, visited points and the index
+// of early exits.
+TEST(INSTRUMENT, COUNTS) {
+  if (!probesEnabled())
+    GTEST_SKIP() << "built without DECIDE_INSTRUMENT";
+
+  std::mt19937 rng(16);
+  CONFIG_T config = randomConfig(rng);
+  // x only decreases from point 6 to 7, so LIC 5 is met at window 6.
+  std::vector<COORDINATE> points;
+  for (int i = 0; i < 10; ++i)
+    points.push_back({i == 7 ? 0.0 : i, 0});
+  Decide decide(points.size(), points, config.PARAMETERS, config.LCM,
+                config.PUV);
+
+  resetProbes();
+  EXPECT_TRUE(decide.Lic5());
+  points[7].x = 7;
+  Decide increasing(points.size(), points, config.PARAMETERS, config.LCM,
+                    config.PUV);
+  EXPECT_FALSE(increasing.Lic5());
+  decide.Calc_PUM();
+
+  PROBE_STATS_T lic5 = probeStats(5);
+  EXPECT_EQ(lic5.CALLS, 2u);
+  EXPECT_EQ(lic5.POINTS_VISITED, 7u + 9u);
+  EXPECT_EQ(lic5.EARLY_EXITS, 1u);
+  EXPECT_EQ(lic5.LAST_EXIT_INDEX, 6);
+  EXPECT_LE(lic5.MAX_NS, lic5.TOTAL_NS);
+  EXPECT_EQ(probeStats(PROBE_CALC_PUM).CALLS, 1u);
+  EXPECT_EQ(probeStats(PROBE_CALC_FUV).CALLS, 0u);
+
+  resetProbes();
+  EXPECT_EQ(probeStats(5).CALLS, 0u);
+  EXPECT_EQ(probeStats(5).LAST_EXIT_INDEX, -1);
+}
+
+// Test that both dumps list every step.
+TEST(INSTRUMENT, DUMPS) {
+  std::ostringstream json;
+  writeProbesJson(json);
+  std::ostringstream prometheus;
+  writeProbesPrometheus(prometheus);
+
+  for (int p = 0; p < PROBE_COUNT; ++p) {
+    const std::string name = probeName(p);
+    EXPECT_NE(json.str().find("{\"name\": \"" + name + "\", \"calls\": "),
+              std::string::npos);
+    EXPECT_NE(
+        prometheus.str().find("decide_probe_calls_total{probe=\"" + name +
+                              "\"} "),
+        std::string::npos);
+  }
+  EXPECT_NE(prometheus.str().find("# TYPE decide_probe_seconds_total counter"),
+            std::string::npos);
+}
@@ -0,0 +1,319 @@
+#include "decide.h"
+#include "geometry.h"
+#include "kernels.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+#include <cmath>
+
+// Test that the pair kernels agree with pointDistance() and compareDoubles()
+// for every gap, on tracks long enough to go through the vectorized blocks and
+// the scalar tail, and on views of a COORDINATE array. The first pair found
+// must be the first one in the track.
+TEST(KERNELS, PAIR_MATCHES_SCALAR) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> length(0, 10);
+
+  for (int run = 0; run < 200; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 2 + run % 70);
+    POINTS_SOA soa(points);
+    int gap = 1 + run % 5;
+    double length1 = length(rng);
+
+    int farther = -1;
+    int closer = -1;
+    for (int i = 0; i + gap < (int)points.size(); ++i) {
+      double distance = pointDistance(points[i], points[i + gap]);
+      if (farther < 0 && compareDoubles(distance, length1) == GT)
+        farther = i;
+      if (closer < 0 && compareDoubles(distance, length1) == LT)
+        closer = i;
+    }
+
+    for (POINTS_VIEW view : {POINTS_VIEW(soa), POINTS_VIEW(points.data())}) {
+      EXPECT_EQ(anyPairFarther(view, soa.size(), gap, length1), farther >= 0);
+      EXPECT_EQ(anyPairCloser(view, soa.size(), gap, length1), closer >= 0);
+      EXPECT_EQ(firstPairAtLeast(view, soa.size(), gap,
+                                 greaterThanSquared(length1)),
+                farther);
+      EXPECT_EQ(
+          firstPairAtMost(view, soa.size(), gap, lessThanSquared(length1)),
+          closer);
+    }
+  }
+}
+
+// Test that distances within the tolerance of LENGTH are neither farther nor
+// closer, and that a NaN distance counts as farther, like in DOUBLECOMPARE.
+TEST(KERNELS, PAIR_TOLERANCE) {
+  std::vector<COORDINATE> points(40, COORDINATE{0, 0});
+  points[33] = {3, 4}; // 5 away from points 32 and 34, in the scalar tail
+  POINTS_SOA soa(points);
+  POINTS_VIEW view(soa);
+
+  EXPECT_FALSE(anyPairFarther(view, 40, 1, 5));
+  EXPECT_FALSE(anyPairFarther(view, 40, 1, 5 - 0.0000005));
+  EXPECT_TRUE(anyPairFarther(view, 40, 1, 5 - 0.000002));
+  EXPECT_FALSE(anyPairCloser(view, 40, 1, 0.0000005));
+  EXPECT_TRUE(anyPairCloser(view, 40, 1, 0.000002));
+
+  soa.x[3] = NAN; // in a vectorized block
+  EXPECT_TRUE(anyPairFarther(view, 40, 1, 100));
+  EXPECT_FALSE(anyPairCloser(view, 8, 1, 0.0000005));
+}
+
+// Test that the LIC 6 kernel agrees with lic6Window() for every window size,
+// including windows whose first and last point coincide.
+TEST(KERNELS, WINDOW_MATCHES_SCALAR) {
+  std::mt19937 rng(8);
+  std::uniform_real_distribution<double> dist(0, 6);
+
+  for (int run = 0; run < 300; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 40);
+    POINTS_SOA soa(points);
+    int n_pts = 3 + run % 6;
+    double distance = dist(rng);
+    double limit = greaterThanSquared(distance);
+
+    bool expected = false;
+    for (size_t i = 0; i + n_pts <= points.size(); ++i) {
+      expected = expected || lic6Window(&points[i], n_pts, limit);
+    }
+
+    EXPECT_EQ(anyWindowFarFromLine(POINTS_VIEW(soa), soa.size(), n_pts,
+                                   distance),
+              expected);
+    EXPECT_EQ(anyWindowFarFromLine(POINTS_VIEW(points.data()), soa.size(),
+                                   n_pts, distance),
+              expected);
+  }
+}
+
+// Test that the branch-free comparisons, scalar and per SIMD lane, agree with
+// compareDoubles() around the tolerance and for NaN and infinities.
+TEST(KERNELS, TOLERANCE_COMPARISONS) {
+  const double values[] = {0,        1e-7,      -1e-7,     1e-6,     -1e-6,
+                           2e-6,     -2e-6,     1,         1 + 1e-6, 1 - 9e-7,
+                           INFINITY, -INFINITY, NAN};
+  for (double a : values) {
+    for (double b : values) {
+      const COMPTYPE expected = compareDoubles(a, b);
+      EXPECT_EQ(greaterWithTolerance(a, b), expected == GT) << a << " " << b;
+      EXPECT_EQ(lessWithTolerance(a, b), expected == LT) << a << " " << b;
+#if defined(__SSE2__)
+      const __m128d lanes_a = _mm_set_pd(a, b);
+      const __m128d lanes_b = _mm_set_pd(b, a);
+      const int reverse = compareDoubles(b, a);
+      EXPECT_EQ(_mm_movemask_pd(greaterMask(lanes_a, lanes_b)),
+                (expected == GT ? 2 : 0) | (reverse == GT ? 1 : 0));
+      EXPECT_EQ(_mm_movemask_pd(lessMask(lanes_a, lanes_b)),
+                (expected == LT ? 2 : 0) | (reverse == LT ? 1 : 0));
+#endif
+    }
+  }
+}
+
+// Test that the x decrease and triangle area scans find the same first window
+// as the scalar tests of LICs 5, 11, 3, 10 and 14.
+TEST(KERNELS, DECREASE_AND_AREA_MATCH_SCALAR) {
+  std::mt19937 rng(20);
+  std::uniform_real_distribution<double> area(0, 20);
+
+  for (int run = 0; run < 300; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 50);
+    const int n = points.size();
+    POINTS_SOA soa(points);
+    const int gap1 = 1 + run % 3;
+    const int gap2 = 1 + run % 2;
+    const double limit = area(rng);
+
+    int decrease = -1;
+    for (int i = 0; i + gap1 < n && decrease < 0; ++i) {
+      if (compareDoubles(points[i + gap1].x - points[i].x, 0) == LT)
+        decrease = i;
+    }
+    int above = -1;
+    int below = -1;
+    for (int i = 0; i + gap1 + gap2 < n; ++i) {
+      const COORDINATE &p1 = points[i];
+      const COORDINATE &p2 = points[i + gap1];
+      const COORDINATE &p3 = points[i + gap1 + gap2];
+      if (above < 0 && twiceAreaAtLeast(p1, p2, p3, greaterThanDoubled(limit)))
+        above = i;
+      if (below < 0 && twiceAreaAtMost(p1, p2, p3, lessThanDoubled(limit)))
+        below = i;
+    }
+
+    for (POINTS_VIEW view : {POINTS_VIEW(soa), POINTS_VIEW(points.data())}) {
+      EXPECT_EQ(firstDecrease(view, n, gap1), decrease);
+      EXPECT_EQ(firstAreaAbove(view, n, gap1, gap2, limit), above);
+      EXPECT_EQ(firstAreaBelow(view, n, gap1, gap2, limit), below);
+    }
+  }
+}
+
+// Test that fitsInCircle() agrees with comparing enclosingRadius() to the
+// radius, for triangles of grid points, many of them right, obtuse or
+// collinear, and radii on and around half their sides, where the tolerance
+// decides. Also test the scan over all of them against the same comparisons.
+TEST(KERNELS, CIRCLE_MATCHES_RADIUS) {
+  std::mt19937 rng(23);
+  const double radii[] = {-1,  -1e-6, 0,   1e-7, 0.5,        1,
+                          1.5, 2,     2.5, 3,    2.5 - 9e-7, 2.5 + 2e-6,
+                          0.5 * std::sqrt(2.0)};
+
+  for (int run = 0; run < 200; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 40);
+    const int n = points.size();
+    POINTS_SOA soa(points);
+    for (double radius : radii) {
+      const double diameter2 = circleDiameter2(radius);
+      int above = -1;
+      int within = -1;
+      for (int i = 0; i + 2 < n; ++i) {
+        const COORDINATE &p1 = points[i], &p2 = points[i + 1],
+                         &p3 = points[i + 2];
+        const bool fits =
+            compareDoubles(enclosingRadius(p1, p2, p3), radius) != GT;
+        EXPECT_EQ(fitsInCircle(p1, p2, p3, diameter2), fits) << radius;
+        if (above < 0 && !fits)
+          above = i;
+        if (within < 0 && fits)
+          within = i;
+      }
+      for (POINTS_VIEW view : {POINTS_VIEW(soa), POINTS_VIEW(points.data())}) {
+        EXPECT_EQ(firstRadiusAbove(view, n, 1, 1, radius), above);
+        EXPECT_EQ(firstRadiusWithin(view, n, 1, 1, radius), within);
+      }
+    }
+  }
+
+  // Collinear points fit in the circle on their outer two, obtuse triangles in
+  // the one on their longest side, which is smaller than their circumcircle.
+  const COORDINATE a = {0, 0}, b = {1, 0}, c = {2, 0}, d = {2, 1};
+  EXPECT_DOUBLE_EQ(enclosingRadius(a, b, c), 1);
+  EXPECT_DOUBLE_EQ(enclosingRadius(a, b, a), 0.5);
+  EXPECT_DOUBLE_EQ(enclosingRadius(a, a, a), 0);
+  EXPECT_DOUBLE_EQ(enclosingRadius({0, 0}, {4, 0}, d), 2);
+  EXPECT_TRUE(fitsInCircle(a, b, c, circleDiameter2(1)));
+  EXPECT_FALSE(fitsInCircle(a, b, c, circleDiameter2(0.99)));
+  EXPECT_FALSE(fitsInCircle({0, 0}, {4, 0}, d, circleDiameter2(1.5)));
+
+  // Tiny acute triangles fit, although the products of their sides underflow.
+  const double t = 1e-90;
+  const std::vector<COORDINATE> tiny = {
+      {0, 0}, {2 * t, 0}, {t, 2 * t}, {3 * t, 2 * t}, {2 * t, 4 * t}};
+  POINTS_SOA tiny_soa(tiny);
+  EXPECT_TRUE(fitsInCircle(tiny[0], tiny[1], tiny[2], circleDiameter2(1)));
+  for (POINTS_VIEW view : {POINTS_VIEW(tiny_soa), POINTS_VIEW(tiny.data())}) {
+    EXPECT_EQ(firstRadiusAbove(view, 5, 1, 1, 1), -1);
+    EXPECT_EQ(firstRadiusWithin(view, 5, 1, 1, 1), 0);
+  }
+}
+
+// Test that the quadrant codes match quadrant(), also on and near the axes,
+// and that the sliding window finds the same first window as counting the
+// quadrants of every window anew.
+TEST(KERNELS, QUADRANT_WINDOW_MATCHES_NAIVE) {
+  std::mt19937 rng(21);
+  std::uniform_int_distribution<int> coordinate(-2, 2);
+
+  for (int run = 0; run < 300; ++run) {
+    const int n = 1 + run % 40;
+    std::vector<COORDINATE> points(n);
+    for (COORDINATE &point : points) {
+      // Multiples of 5e-7, so some are within the tolerance of an axis.
+      point.x = coordinate(rng) * 5e-7;
+      point.y = coordinate(rng) * 5e-7;
+    }
+    POINTS_SOA soa(points);
+    const int q_pts = run % 7;
+    const int quads = run % 4;
+
+    int expected = -1;
+    for (int i = 0; i + q_pts <= n && expected < 0; ++i) {
+      bool occupied[4] = {false, false, false, false};
+      for (int j = i; j < i + q_pts; ++j)
+        occupied[quadrant(points[j])] = true;
+      if (occupied[0] + occupied[1] + occupied[2] + occupied[3] > quads)
+        expected = i;
+    }
+
+    for (POINTS_VIEW view : {POINTS_VIEW(soa), POINTS_VIEW(points.data())}) {
+      std::vector<uint8_t> codes(n);
+      quadrantCodes(view, n, codes.data());
+      for (int i = 0; i < n; ++i)
+        EXPECT_EQ(codes[i], quadrant(points[i]));
+      EXPECT_EQ(firstQuadrantWindow(codes.data(), n, q_pts, quads), expected);
+    }
+  }
+}
+
+// Test that the kernels gapKernels() selects, with the gaps compiled in or
+// not, find the same first window as the functions that take the gaps at run
+// time, and that those match the scalar tests of LICs 8, 9 and 13. The gap
+// parameters range over common values and beyond.
+TEST(KERNELS, GAP_KERNELS_MATCH_RUNTIME) {
+  std::mt19937 rng(22);
+  std::uniform_int_distribution<int> pts(0, 6);
+  std::uniform_real_distribution<double> limit(0, 20);
+  std::uniform_real_distribution<double> epsilon(-0.5, PI + 0.5);
+
+  for (int run = 0; run < 300; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 50);
+    const int n = points.size();
+    POINTS_SOA soa(points);
+    PARAMETERS_T p = randomParameters(rng);
+    p.K_PTS = pts(rng);
+    p.A_PTS = pts(rng);
+    p.B_PTS = pts(rng);
+    p.C_PTS = pts(rng);
+    p.D_PTS = pts(rng);
+    p.E_PTS = pts(rng);
+    p.F_PTS = pts(rng);
+    p.G_PTS = pts(rng);
+    const GAP_KERNELS_T kernels = gapKernels(p);
+    const double value = limit(rng);
+    p.EPSILON = epsilon(rng);
+    const ANGLE_BOUNDS_T bounds = angleBounds(p.EPSILON);
+
+    const int a = p.A_PTS + 1, b = p.B_PTS + 1;
+    const int c = p.C_PTS + 1, d = p.D_PTS + 1;
+    int larger = -1;
+    int smaller = -1;
+    for (int i = 0; i + a + b < n; ++i) {
+      const double radius =
+          enclosingRadius(points[i], points[i + a], points[i + a + b]);
+      if (larger < 0 && compareDoubles(radius, value) == GT)
+        larger = i;
+      if (smaller < 0 && compareDoubles(radius, value) != GT)
+        smaller = i;
+    }
+    int angle = -1;
+    for (int i = 0; i + c + d < n && angle < 0; ++i) {
+      if (angleOutsidePi(points[i], points[i + c], points[i + c + d],
+                         p.EPSILON))
+        angle = i;
+    }
+
+    const int k = p.K_PTS + 1, g = p.G_PTS + 1;
+    const int e = p.E_PTS + 1, f = p.F_PTS + 1;
+    for (POINTS_VIEW view : {POINTS_VIEW(soa), POINTS_VIEW(points.data())}) {
+      EXPECT_EQ(firstRadiusAbove(view, n, a, b, value), larger);
+      EXPECT_EQ(firstRadiusWithin(view, n, a, b, value), smaller);
+      EXPECT_EQ(firstAngleOutside(view, n, c, d, bounds), angle);
+
+      EXPECT_EQ(kernels.pair_at_least(view, n, k, value),
+                firstPairAtLeast(view, n, k, value));
+      EXPECT_EQ(kernels.pair_at_most(view, n, k, value),
+                firstPairAtMost(view, n, k, value));
+      EXPECT_EQ(kernels.radius_above(view, n, a, b, value), larger);
+      EXPECT_EQ(kernels.radius_within(view, n, a, b, value), smaller);
+      EXPECT_EQ(kernels.angle_outside(view, n, c, d, bounds), angle);
+      EXPECT_EQ(kernels.area_above(view, n, e, f, value),
+                firstAreaAbove(view, n, e, f, value));
+      EXPECT_EQ(kernels.area_below(view, n, e, f, value),
+                firstAreaBelow(view, n, e, f, value));
+      EXPECT_EQ(kernels.decrease(view, n, g), firstDecrease(view, n, g));
+    }
+  }
+}
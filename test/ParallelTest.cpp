@@ -0,0 +1,175 @@
+#include "decide.h"
+#include "parallel.h"
+#include "parallel_engine.h"
+#include "random_input.h"
+#include "thread_pool.h"
+#include "gtest/gtest.h"
+
+// Test that the parallel CMV is the serial one, for different numbers of
+// threads and with chunks small enough that every LIC is split up.
+TEST(PARALLEL, MATCHES_SERIAL) {
+  std::mt19937 rng(4);
+  ThreadPool pool1(1);
+  ThreadPool pool4(4);
+
+  LCM_T lcm = randomLcm(rng);
+  std::array<bool, 15> puv = randomPuv(rng);
+
+  for (int run = 0; run < 200; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 60);
+    PARAMETERS_T parameters = randomParameters(rng);
+    // Large thresholds for some runs, so that LICs have to scan every chunk.
+    if (run % 2) {
+      parameters.LENGTH1 = parameters.RADIUS1 = parameters.AREA1 = 100;
+      parameters.DIST = 100;
+    }
+
+    Decide decide(points.size(), points, parameters, lcm, puv);
+    decide.Calc_CMV();
+
+    // Both the SIMD (separate arrays) and the strided (COORDINATE array) path.
+    POINTS_SOA soa(points);
+    POINTS_VIEW arrays(soa);
+    POINTS_VIEW coordinates(points.data());
+    for (int chunk : {1, 7, 8192}) {
+      EXPECT_EQ(parallelCMV(pool1, points.size(), arrays, parameters, chunk),
+                decide.CMV);
+      EXPECT_EQ(parallelCMV(pool4, points.size(), arrays, parameters, chunk),
+                decide.CMV);
+      EXPECT_EQ(
+          parallelCMV(pool4, points.size(), coordinates, parameters, chunk),
+          decide.CMV);
+    }
+  }
+}
+
+// Test that decide() on a pool gives the launch decision of LAUNCH_POSITIVE.
+TEST(PARALLEL, LAUNCH_POSITIVE) {
+  std::vector<COORDINATE> points = {{0, 0},  {100, 100}, {0, 0},  {20, 0},
+                                    {0, 20}, {0, 0},     {50, 0}, {100, 100}};
+
+  PARAMETERS_T parameters = {100, 9.5, 0, 5, 0, 0, 10, 3, 0, 0,
+                             0,   0,   0, 1, 1, 0, 0,  0, 0};
+
+  LCM_T lcm;
+  for (auto &row : lcm)
+    row.fill(NOTUSED);
+  lcm[0].fill(ORR);
+  lcm[3].fill(ORR);
+  lcm[6].fill(ORR);
+
+  std::array<bool, 15> puv = {false};
+  puv[0] = puv[3] = puv[6] = true;
+
+  ThreadPool pool(3);
+  Decide decide(points.size(), points, parameters, lcm, puv);
+  decide.decide(pool);
+
+  EXPECT_EQ(decide.CMV[0], true);
+  EXPECT_EQ(decide.CMV[3], true);
+  EXPECT_EQ(decide.CMV[6], true);
+  EXPECT_EQ(decide.LAUNCH, true);
+}
+
+// Test that wait() returns only after every task has run, also when the pool
+// is reused.
+TEST(PARALLEL, THREAD_POOL_WAIT) {
+  ThreadPool pool(2);
+  std::atomic<int> count(0);
+  for (int round = 1; round <= 3; ++round) {
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&count] { ++count; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, round * 1000);
+  }
+}
+
+// Test that tasks submitted by a task, which go to the queue of its worker
+// or are dealt out if wait() runs it, all run before wait() returns, and that
+// worker() tells where each runs: size() on the thread in wait(), and on a
+// worker thread an index of its own, the same for every task it runs.
+TEST(PARALLEL, THREAD_POOL_NESTED_SUBMIT) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.worker(), pool.size());
+  const std::thread::id caller = std::this_thread::get_id();
+  std::mutex mutex;
+  std::vector<std::thread::id> threads(pool.size());
+  std::atomic<int> count(0);
+  std::atomic<int> wrong(0);
+  auto check = [&] {
+    const int worker = pool.worker();
+    const std::thread::id self = std::this_thread::get_id();
+    if (self == caller) {
+      wrong += worker != pool.size();
+      return;
+    }
+    if (worker < 0 || worker >= pool.size()) {
+      ++wrong;
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (threads[worker] == std::thread::id())
+      threads[worker] = self;
+    wrong += threads[worker] != self;
+  };
+  pool.submit([&] {
+    check();
+    for (int i = 0; i < 1000; ++i) {
+      pool.submit([&] {
+        check();
+        ++count;
+      });
+    }
+  });
+  pool.wait();
+  EXPECT_EQ(count, 1000);
+  EXPECT_EQ(wrong, 0);
+
+  // No two workers share a thread.
+  for (int a = 0; a < pool.size(); ++a) {
+    for (int b = a + 1; b < pool.size(); ++b) {
+      if (threads[a] != std::thread::id()) {
+        EXPECT_NE(threads[a], threads[b]);
+      }
+    }
+  }
+}
+
+// Test that a batch gets the decision of DecideEngine for every frame, with
+// packs and splits small enough that frames are packed into tasks of several
+// sizes and the longest frames are split, on one worker and on several.
+TEST(PARALLEL, BATCH_MATCHES_ENGINE) {
+  std::mt19937 rng(25);
+  ThreadPool pool1(1);
+  ThreadPool pool4(4);
+
+  for (int run = 0; run < 20; ++run) {
+    CompiledConfig config(randomConfig(rng));
+    DecideEngine reference(config);
+
+    std::vector<POINTS_SOA> tracks;
+    for (int f = 0; f < 100; ++f) {
+      tracks.push_back(POINTS_SOA(randomPoints(rng, (f * 37 + run) % 90)));
+    }
+    std::vector<FRAME_T> frames;
+    std::vector<DECISION_T> expected;
+    for (const POINTS_SOA &track : tracks) {
+      FRAME_T frame = {track.size(), POINTS_VIEW(track)};
+      frames.push_back(frame);
+      expected.push_back(reference.evaluate(frame.NUMPOINTS, frame.POINTS));
+    }
+
+    for (int pack : {1, 64, 4096}) {
+      for (ThreadPool *pool : {&pool1, &pool4}) {
+        ParallelEngine engine(*pool, config, pack, 80);
+        std::vector<DECISION_T> decisions(frames.size());
+        engine.decideBatch(frames.data(), frames.size(), decisions.data());
+        for (size_t f = 0; f < frames.size(); ++f) {
+          EXPECT_EQ(decisions[f].CMV, expected[f].CMV) << f;
+          EXPECT_EQ(decisions[f].LAUNCH, expected[f].LAUNCH) << f;
+        }
+      }
+    }
+  }
+}
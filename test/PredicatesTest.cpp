@@ -0,0 +1,85 @@
+#include "geometry.h"
+#include "kernels.h"
+#include "gtest/gtest.h"
+#include <cmath>
+#include <cstdlib>
+
+// Points around the line through FIRST in direction (3, 4) * M: point (s, t)
+// is FIRST + s (3, 4) + t (-4, 3), whose cross product with the direction is
+// 25 M t, and whose distance from the line is 5 |t|. The coordinates are
+// integers, so their differences are exact, but the products of differences
+// take more than the 53 bits of a double.
+static const double FIRST = 2147483648.0; // 2^31
+static const double M = 67108865.0;       // 2^26 + 1
+
+static COORDINATE aroundLine(double s, double t) {
+  COORDINATE p = {FIRST + 3 * s - 4 * t, FIRST + 4 * s + 3 * t};
+  return p;
+}
+
+// Test the area and line distance predicates on points one unit either side
+// of their thresholds, and on them, where rounding makes plain floating point
+// go either way. t = k + jitter is at least k in magnitude exactly when twice
+// the area 25 M |t| is at least 25 M k, and the squared distance 25 t^2 at
+// least 25 k^2.
+TEST(PREDICATES, AREA_AND_LINE_AT_THRESHOLD) {
+  const COORDINATE first = aroundLine(0, 0);
+  const COORDINATE last = {FIRST + 3 * M, FIRST + 4 * M};
+  int rounded = 0;
+
+  for (int k = 0; k < 20; ++k) {
+    for (int n = 0; n < 50; ++n) {
+      const double s = 134217728.0 + 7919 * n * (k + 1); // about 2^27
+      for (int jitter = -1; jitter <= 1; ++jitter) {
+        const COORDINATE point = aroundLine(s, k + jitter);
+        const bool farther = std::abs(k + jitter) >= k;
+        const bool nearer = std::abs(k + jitter) <= k;
+        const double area = 25 * M * k;
+        EXPECT_EQ(twiceAreaAtLeast(first, last, point, area), farther);
+        EXPECT_EQ(twiceAreaAtMost(first, last, point, area), nearer);
+        EXPECT_EQ(!(lineDistanceSign(first, last, point, 25.0 * k * k) < 0),
+                  farther);
+
+        const double cross = (last.x - first.x) * (point.y - first.y) -
+                             (last.y - first.y) * (point.x - first.x);
+        rounded += !(std::fabs(cross) < area) != farther;
+      }
+    }
+  }
+  // Some threshold cases must have come out wrong in plain floating point.
+  EXPECT_GT(rounded, 0);
+}
+
+// Test the point distance predicate of coincident LIC 6 windows where the
+// squared distance 2^60 + b^2 has more bits than a double. It is at least
+// 2^60 + 256 c^2 exactly when b = 16 c + jitter is at least 16 c.
+TEST(PREDICATES, DISTANCE_AT_THRESHOLD) {
+  const COORDINATE first = {FIRST, FIRST};
+  for (int c = 1; c <= 10; ++c) {
+    const double limit = std::ldexp(1, 60) + 256.0 * c * c;
+    for (int jitter = -1; jitter <= 1; ++jitter) {
+      const COORDINATE point = {FIRST + std::ldexp(1, 30),
+                                FIRST + 16 * c + jitter};
+      EXPECT_EQ(!(distanceSign(first, point, limit) < 0), jitter >= 0);
+    }
+  }
+}
+
+// Test that a NaN area counts as above a threshold and not below, like a NaN
+// distance, and that the thresholds follow the tolerance of DOUBLECOMPARE.
+TEST(PREDICATES, NAN_AND_TOLERANCE) {
+  const COORDINATE p1 = {0, 0};
+  const COORDINATE p2 = {1, 0};
+  const COORDINATE nan = {NAN, 1};
+  EXPECT_TRUE(twiceAreaAtLeast(p1, p2, nan, 1));
+  EXPECT_FALSE(twiceAreaAtMost(p1, p2, nan, 1));
+
+  // A triangle of area 0.5 is neither GT nor LT to 0.5, nor to 0.5 + 1e-7.
+  const COORDINATE p3 = {0, 1};
+  for (double area : {0.5, 0.5 + 1e-7}) {
+    EXPECT_FALSE(twiceAreaAtLeast(p1, p2, p3, greaterThanDoubled(area)));
+    EXPECT_FALSE(twiceAreaAtMost(p1, p2, p3, lessThanDoubled(area)));
+  }
+  EXPECT_TRUE(twiceAreaAtLeast(p1, p2, p3, greaterThanDoubled(0.4)));
+  EXPECT_TRUE(twiceAreaAtMost(p1, p2, p3, lessThanDoubled(0.6)));
+}
@@ -0,0 +1,75 @@
+#include "decide.h"
+#include "engine.h"
+#include "profile.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+#include <sstream>
+
+// Test that LICs are ordered by cost per decision, with unmeasured LICs first
+// and LICs that are not needed last.
+TEST(PROFILE, ORDER) {
+  std::array<int, 15> default_order = {0, 1, 2,  3,  4,  5,  6, 7,
+                                       8, 9, 10, 11, 12, 13, 14};
+  LicProfile profile(0.5);
+  profile.record(1, 1000, true); // 1000 per decision
+  profile.record(2, 10, false);  // 10000 per decision
+  profile.record(3, 100, true);  // 100 per decision
+  profile.record(4, 100, true);  // not needed
+
+  const uint16_t needed = 1 << 0 | 1 << 1 | 1 << 2 | 1 << 3;
+  std::array<int, 15> order = profile.order(needed, default_order);
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[1], 3);
+  EXPECT_EQ(order[2], 1);
+  EXPECT_EQ(order[3], 2);
+
+  // The averages decay towards new samples.
+  profile.record(3, 10000, false);
+  EXPECT_DOUBLE_EQ(profile.averageCost(3), 5050);
+  EXPECT_DOUBLE_EQ(profile.decisiveness(3), 0.5);
+  EXPECT_EQ(profile.sampleCount(3), 2u);
+}
+
+// Test that a saved profile loads back, and that malformed input is rejected
+// without changing the profile.
+TEST(PROFILE, SAVE_LOAD) {
+  LicProfile profile;
+  profile.record(6, 1234.5, true);
+  profile.record(6, 1000.0 / 3, false);
+  profile.record(9, 42, false);
+  std::stringstream saved;
+  profile.save(saved);
+
+  // The averages come back exactly, and so does the order.
+  LicProfile loaded;
+  ASSERT_TRUE(loaded.load(saved));
+  for (int l = 0; l < 15; ++l) {
+    EXPECT_EQ(loaded.averageCost(l), profile.averageCost(l));
+    EXPECT_EQ(loaded.decisiveness(l), profile.decisiveness(l));
+    EXPECT_EQ(loaded.sampleCount(l), profile.sampleCount(l));
+  }
+
+  std::istringstream truncated("0 1 2.5 1\n1 1 3 0\n");
+  EXPECT_FALSE(loaded.load(truncated));
+  EXPECT_EQ(loaded.averageCost(6), profile.averageCost(6));
+}
+
+// Test that launch() with a profile, whose order changes as it learns, gives
+// the launch decision of full evaluation.
+TEST(PROFILE, ENGINE_MATCHES_FULL) {
+  std::mt19937 rng(15);
+
+  for (int run = 0; run < 20; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    config.PUV.fill(true);
+    DecideEngine full{CompiledConfig(config)};
+    DecideEngine adaptive{CompiledConfig(config)};
+    LicProfile profile;
+    adaptive.useProfile(&profile);
+
+    for (int frame = 0; frame < 3 * DecideEngine::REORDER_INTERVAL; ++frame) {
+      std::vector<COORDINATE> points = randomPoints(rng, 5 + frame % 20);
+      EXPECT_EQ(adaptive.launch(points), full.evaluate(points).LAUNCH);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+#include "engine.h"
+#include "input.h"
+#include "random_input.h"
+#include "server.h"
+#include "gtest/gtest.h"
+#include <unistd.h>
+
+// A request with the given id ("" for none) and input.
+static std::string request(const std::string &id, const std::string &input) {
+  std::string header = std::to_string(input.size());
+  if (!id.empty())
+    header += " " + id;
+  return header + "\n" + input;
+}
+
+// Requests alternating between text and binary input, some with ids, and the
+// answers expected for them. Runs of requests share their configuration.
+static void randomRequests(std::mt19937 &rng, int COUNT, std::string &REQUESTS,
+                           std::string &ANSWERS) {
+  CONFIG_T config = randomConfig(rng);
+  for (int r = 0; r < COUNT; ++r) {
+    if (r % 5 == 0)
+      config = randomConfig(rng);
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + r % 30);
+    DecideEngine engine{CompiledConfig(config)};
+    const bool launch = engine.evaluate(points).LAUNCH;
+
+    const std::string id = r % 3 == 0 ? "" : "frame-" + std::to_string(r);
+    const std::string input =
+        r % 2 == 0 ? textInput(points, config) : encodeFrame(points, config);
+    REQUESTS += request(id, input);
+    ANSWERS += (id.empty() ? "" : id + " ") + (launch ? "YES\n" : "NO\n");
+  }
+}
+
+// Test that the answers match the engine, however the stream is split into
+// reads, and that incomplete requests wait for the rest of their data.
+TEST(SERVER, ANSWERS_REQUESTS) {
+  std::mt19937 rng(17);
+  std::string requests;
+  std::string expected;
+  randomRequests(rng, 40, requests, expected);
+
+  for (size_t chunk : {requests.size(), (size_t)1, (size_t)7, (size_t)500}) {
+    FrameServer server;
+    std::string buffered;
+    std::string answers;
+    for (size_t i = 0; i < requests.size(); i += chunk) {
+      buffered += requests.substr(i, chunk);
+      buffered.erase(0, server.process(buffered.data(), buffered.size(),
+                                       answers));
+    }
+    EXPECT_TRUE(buffered.empty());
+    EXPECT_FALSE(server.broken());
+    EXPECT_EQ(answers, expected);
+  }
+}
+
+// Test that a server with a profile gives the same answers, and learns the
+// costs of the LICs its engines compute.
+TEST(SERVER, PROFILE) {
+  std::mt19937 rng(20);
+  std::string requests;
+  std::string expected;
+  randomRequests(rng, 40, requests, expected);
+
+  LicProfile profile;
+  FrameServer server(&profile);
+  std::string answers;
+  EXPECT_EQ(server.process(requests.data(), requests.size(), answers),
+            requests.size());
+  EXPECT_EQ(answers, expected);
+
+  uint64_t samples = 0;
+  for (int l = 0; l < 15; ++l)
+    samples += profile.sampleCount(l);
+  EXPECT_GT(samples, 0u);
+}
+
+// Test that invalid inputs are answered with an error and the stream goes on,
+// but that a malformed header ends it.
+TEST(SERVER, ERRORS) {
+  std::mt19937 rng(18);
+  CONFIG_T config = randomConfig(rng);
+  std::string frame = encodeFrame(randomPoints(rng, 5), config);
+  frame.resize(frame.size() - 8);
+
+  FrameServer server;
+  std::string answers;
+  std::string requests = request("a", "x") + request("b", frame) +
+                         request("c", "2000000000 ") +
+                         request("d", "2 1 2 3 x y ") +
+                         request("", textInput({}, config));
+  EXPECT_EQ(server.process(requests.data(), requests.size(), answers),
+            requests.size());
+  EXPECT_EQ(answers, "a ERROR Invalid NUMPOINTS\n"
+                     "b ERROR Frame is shorter than its NUMPOINTS\n"
+                     "c ERROR Input is shorter than its NUMPOINTS\n"
+                     "d ERROR Invalid points\n"
+                     "NO\n");
+
+  for (std::string header : {"12x\n", "\n", "12 \n", "12 a b\n", "-1\n"}) {
+    FrameServer fresh;
+    answers.clear();
+    fresh.process(header.data(), header.size(), answers);
+    EXPECT_TRUE(fresh.broken()) << header;
+    EXPECT_EQ(answers, "ERROR Malformed header\n");
+  }
+}
+
+// Test serving a stream between file descriptors.
+TEST(SERVER, STREAM) {
+  std::mt19937 rng(19);
+  std::string requests;
+  std::string expected;
+  randomRequests(rng, 8, requests, expected);
+
+  int in[2];
+  int out[2];
+  ASSERT_EQ(pipe(in), 0);
+  ASSERT_EQ(pipe(out), 0);
+  ASSERT_LT(requests.size(), (size_t)16384); // fits in the pipe
+  ASSERT_EQ(write(in[1], requests.data(), requests.size()),
+            (ssize_t)requests.size());
+  close(in[1]);
+
+  EXPECT_TRUE(serveStream(in[0], out[1]));
+  close(in[0]);
+  close(out[1]);
+
+  std::string answers;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(out[0], buffer, sizeof buffer)) > 0)
+    answers.append(buffer, n);
+  close(out[0]);
+  EXPECT_EQ(answers, expected);
+}
@@ -0,0 +1,121 @@
+#include "engine.h"
+#include "random_input.h"
+#include "typed_engine.h"
+#include "gtest/gtest.h"
+#include <limits>
+
+// Coordinates of type T, as separate x and y arrays.
+template <typename T> struct TYPED_POINTS {
+  std::vector<T> x;
+  std::vector<T> y;
+
+  explicit TYPED_POINTS(const std::vector<COORDINATE> &POINTS) {
+    for (const COORDINATE &point : POINTS) {
+      x.push_back((T)point.x);
+      y.push_back((T)point.y);
+    }
+  }
+};
+
+// Test the accuracy of the float and int32_t engines against the double one,
+// on random tracks of grid points. Grid points are exact in every type, so
+// the double engine is exact up to its tolerance, and int32_t, whose squared
+// distances and areas are exact too, must agree on every entry. float rounds
+// the squared distances and thresholds, so it may only differ where a value
+// is within rounding of a threshold, which random thresholds rarely are.
+TEST(TYPED_ENGINE, ACCURACY) {
+  std::mt19937 rng(19);
+  int entries = 0;
+  int float_differences = 0;
+
+  for (int run = 0; run < 100; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    CompiledConfig compiled(config);
+    DecideEngine reference(compiled);
+    TypedEngine<double> doubles(compiled);
+    TypedEngine<float> floats(compiled);
+    TypedEngine<int32_t> integers(compiled);
+
+    for (int frame = 0; frame < 10; ++frame) {
+      std::vector<COORDINATE> points = randomPoints(rng, frame * 7 % 60);
+      TYPED_POINTS<double> d(points);
+      TYPED_POINTS<float> f(points);
+      TYPED_POINTS<int32_t> i(points);
+
+      const DECISION_T expected = reference.evaluate(points);
+      EXPECT_EQ(doubles.evaluate(d.x, d.y).CMV, expected.CMV);
+      EXPECT_EQ(doubles.evaluate(d.x, d.y).LAUNCH, expected.LAUNCH);
+      EXPECT_EQ(integers.evaluate(i.x, i.y).CMV, expected.CMV);
+      EXPECT_EQ(integers.evaluate(i.x, i.y).LAUNCH, expected.LAUNCH);
+
+      const DECISION_T &single = floats.evaluate(f.x, f.y);
+      for (int l = 0; l < 15; ++l) {
+        ++entries;
+        float_differences += single.CMV[l] != expected.CMV[l];
+      }
+    }
+  }
+  EXPECT_LE(float_differences, entries / 1000);
+}
+
+// Test that the int32_t engine is exact at the ends of its coordinate range,
+// where squared distances and the terms of areas take more than the 53 bits
+// of a double.
+TEST(TYPED_ENGINE, INT32_EXTREMES) {
+  const int32_t M = SCALAR_TRAITS<int32_t>::MAX_COORDINATE - 1;
+  std::vector<int32_t> x = {-M, M, M - 1};
+  std::vector<int32_t> y = {-M, M, M - 2};
+
+  CONFIG_T config;
+  config.PARAMETERS = {0, 0, 0, 0, 0, 0, 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0};
+  for (auto &row : config.LCM)
+    row.fill(NOTUSED);
+  config.PUV.fill(false);
+
+  // The first two points are 2M * sqrt(2) apart, just below 2^63 squared.
+  const double diagonal = 2.0 * M * std::sqrt(2.0);
+  config.PARAMETERS.LENGTH1 = diagonal - 0.5;
+  TypedEngine<int32_t> shorter{CompiledConfig(config)};
+  EXPECT_TRUE(shorter.evaluate(x, y).CMV[0]);
+  config.PARAMETERS.LENGTH1 = diagonal + 0.5;
+  TypedEngine<int32_t> longer{CompiledConfig(config)};
+  EXPECT_FALSE(longer.evaluate(x, y).CMV[0]);
+
+  // The three points span an area of exactly M, from terms of about 2^61.
+  config.PARAMETERS.AREA1 = M - 1;
+  TypedEngine<int32_t> smaller{CompiledConfig(config)};
+  EXPECT_TRUE(smaller.evaluate(x, y).CMV[3]);
+  config.PARAMETERS.AREA1 = M;
+  TypedEngine<int32_t> equal{CompiledConfig(config)};
+  EXPECT_FALSE(equal.evaluate(x, y).CMV[3]);
+}
+
+// Test that int32_t frames with coordinates beyond MAX_COORDINATE, whose
+// squared distances would overflow 64 bits, get the decisions of the double
+// engine.
+TEST(TYPED_ENGINE, INT32_BEYOND_RANGE) {
+  std::mt19937 rng(31);
+  const int32_t MIN = std::numeric_limits<int32_t>::min();
+  const int32_t MAX = std::numeric_limits<int32_t>::max();
+  const int32_t EDGE = SCALAR_TRAITS<int32_t>::MAX_COORDINATE;
+  const std::vector<std::vector<int32_t>> extremes = {
+      {MIN, MAX, 0, MIN, MAX}, {EDGE, -EDGE, 1, 2, 3}, {0, 1, 2, MAX, 4}};
+
+  for (int run = 0; run < 20; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    config.PARAMETERS.LENGTH1 = 1e9;
+    CompiledConfig compiled(config);
+    DecideEngine reference(compiled);
+    TypedEngine<int32_t> integers(compiled);
+
+    for (const std::vector<int32_t> &x : extremes) {
+      const std::vector<int32_t> &y = extremes[run % extremes.size()];
+      std::vector<COORDINATE> points;
+      for (size_t i = 0; i < x.size(); ++i)
+        points.push_back({(double)x[i], (double)y[i]});
+      const DECISION_T expected = reference.evaluate(points);
+      EXPECT_EQ(integers.evaluate(x, y).CMV, expected.CMV);
+      EXPECT_EQ(integers.evaluate(x, y).LAUNCH, expected.LAUNCH);
+    }
+  }
+}
@@ -0,0 +1,54 @@
+#include "random_input.h"
+#include "unlock.h"
+#include "gtest/gtest.h"
+
+// Test that the bit sliced launch decision, FUV and PUM of each of 64 frames
+// match steps 2.2 - 2.4 run on that frame alone.
+TEST(BITSLICED, MATCHES_SINGLE_FRAME) {
+  std::mt19937 rng(64);
+  std::bernoulli_distribution cmv_entry(0.8);
+
+  for (int run = 0; run < 50; ++run) {
+    LCM_T lcm = randomLcm(rng);
+    std::array<bool, 15> puv = randomPuv(rng);
+    BitslicedLaunch bitsliced(lcm, puv);
+
+    CMV_BITS_T bits = {};
+    std::vector<std::array<bool, 15>> cmvs(64);
+    for (int frame = 0; frame < 64; ++frame) {
+      for (bool &entry : cmvs[frame])
+        entry = cmv_entry(rng);
+      packCMV(cmvs[frame], frame, bits);
+    }
+
+    uint64_t launch = bitsliced.launch(bits);
+    for (int frame = 0; frame < 64; ++frame) {
+      EXPECT_EQ(unpackCMV(bits, frame), cmvs[frame]);
+
+      PUM_T pum, expected_pum;
+      std::array<bool, 15> fuv, expected_fuv;
+      calcPUM(cmvs[frame], lcm, expected_pum);
+      calcFUV(expected_pum, puv, expected_fuv);
+      bitsliced.pum(bits, frame, pum);
+      bitsliced.fuv(bits, frame, fuv);
+
+      EXPECT_EQ(pum, expected_pum);
+      EXPECT_EQ(fuv, expected_fuv);
+      EXPECT_EQ((launch >> frame) & 1, calcLAUNCH(expected_fuv));
+    }
+  }
+}
+
+// Test that repacking a frame overwrites its previous CMV.
+TEST(BITSLICED, REPACK_FRAME) {
+  CMV_BITS_T bits = {};
+  std::array<bool, 15> cmv;
+  cmv.fill(true);
+  packCMV(cmv, 63, bits);
+  cmv[4] = false;
+  packCMV(cmv, 63, bits);
+
+  EXPECT_EQ(unpackCMV(bits, 63), cmv);
+  EXPECT_EQ(bits[4], 0u);
+  EXPECT_EQ(bits[5], uint64_t(1) << 63);
+}
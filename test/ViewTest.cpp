@@ -0,0 +1,37 @@
+#include "decide.h"
+#include "random_input.h"
+#include "gtest/gtest.h"
+
+// Test that Decide on borrowed points, either separate x and y arrays or an
+// array of COORDINATE, computes the same CMV and launch decision as Decide on
+// its own copy of the points.
+TEST(VIEW, MATCHES_COPY) {
+  std::mt19937 rng(9);
+
+  for (int run = 0; run < 200; ++run) {
+    std::vector<COORDINATE> points = randomPoints(rng, 3 + run % 60);
+    CONFIG_T config = randomConfig(rng);
+    const int numpoints = points.size();
+
+    Decide copy(numpoints, points, config.PARAMETERS, config.LCM, config.PUV);
+    copy.Calc_CMV();
+    copy.Calc_PUM();
+    copy.Calc_FUV();
+    copy.Calc_LAUNCH();
+
+    POINTS_SOA soa(points);
+    Decide arrays(numpoints, POINTS_VIEW(soa), config.PARAMETERS, config.LCM,
+                  config.PUV);
+    Decide coordinates(numpoints, POINTS_VIEW(points.data()),
+                       config.PARAMETERS, config.LCM, config.PUV);
+
+    for (Decide *view : {&arrays, &coordinates}) {
+      view->Calc_CMV();
+      view->Calc_PUM();
+      view->Calc_FUV();
+      view->Calc_LAUNCH();
+      EXPECT_EQ(view->CMV, copy.CMV);
+      EXPECT_EQ(view->LAUNCH, copy.LAUNCH);
+    }
+  }
+}
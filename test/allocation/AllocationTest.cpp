@@ -0,0 +1,106 @@
+#include "../random_input.h"
+#include "decide.h"
+#include "engine.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Every allocation and deallocation of the process, counted by the
+// replacements of the global operator new and delete below. This is why the
+// test has an executable of its own.
+static std::atomic<long> allocations(0);
+static std::atomic<long> deallocations(0);
+
+void *operator new(size_t SIZE) {
+  ++allocations;
+  void *pointer = std::malloc(SIZE == 0 ? 1 : SIZE);
+  if (pointer == nullptr)
+    throw std::bad_alloc();
+  return pointer;
+}
+
+void *operator new(size_t SIZE, const std::nothrow_t &) noexcept {
+  ++allocations;
+  return std::malloc(SIZE == 0 ? 1 : SIZE);
+}
+
+void operator delete(void *POINTER) noexcept {
+  if (POINTER != nullptr)
+    ++deallocations;
+  std::free(POINTER);
+}
+
+void operator delete(void *POINTER, size_t) noexcept {
+  operator delete(POINTER);
+}
+
+void operator delete(void *POINTER, const std::nothrow_t &) noexcept {
+  operator delete(POINTER);
+}
+
+// Allocations and deallocations made while running CALL.
+template <typename CALL> static long heapTraffic(CALL call) {
+  const long before = allocations + deallocations;
+  call();
+  return allocations + deallocations - before;
+}
+
+// Stream buffer that drops everything, for the YES/NO printed by decide().
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+};
+
+// Test that the counting sees allocations at all.
+TEST(ALLOCATION, COUNTS) {
+  std::vector<int> *values = nullptr;
+  EXPECT_EQ(heapTraffic([&values] { values = new std::vector<int>(100); }),
+            2);
+  EXPECT_EQ(values->size(), 100u);
+  EXPECT_EQ(heapTraffic([values] { delete values; }), 2);
+}
+
+// Test that decide() does not allocate once Decide is constructed over
+// borrowed points, for short tracks and for tracks long enough for the
+// FrameCache to grow during the decision.
+TEST(ALLOCATION, DECIDE) {
+  std::mt19937 rng(21);
+  NullBuffer null;
+  std::streambuf *out = std::cout.rdbuf(&null);
+
+  for (int run = 0; run < 100; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    POINTS_SOA points(randomPoints(rng, run % 10 == 0 ? 3000 : run % 60));
+    Decide decide(points.size(), POINTS_VIEW(points), config.PARAMETERS,
+                  config.LCM, config.PUV);
+
+    EXPECT_EQ(heapTraffic([&decide] { decide.decide(); }), 0);
+  }
+  std::cout.rdbuf(out);
+}
+
+// Test that evaluate() and launch() of an engine, with and without a
+// profile, do not allocate for frames up to the length reserved for.
+TEST(ALLOCATION, ENGINE) {
+  std::mt19937 rng(22);
+  LicProfile profile;
+
+  for (int run = 0; run < 50; ++run) {
+    CONFIG_T config = randomConfig(rng);
+    DecideEngine engine{CompiledConfig(config)};
+    engine.reserve(3000);
+    if (run % 2 == 1)
+      engine.useProfile(&profile);
+
+    for (int frame = 0; frame < 20; ++frame) {
+      POINTS_SOA points(randomPoints(rng, frame == 0 ? 3000 : frame * 7 % 60));
+      const POINTS_VIEW view(points);
+      const int n = points.size();
+
+      EXPECT_EQ(heapTraffic([&] { engine.evaluate(n, view); }), 0);
+      EXPECT_EQ(heapTraffic([&] { engine.launch(n, view); }), 0);
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef RANDOM_INPUT_H
+#define RANDOM_INPUT_H
+
+#include "decide.h"
+#include <random>
+#include <sstream>
+#include <string>
+
+// Random inputs for tests that compare different evaluators with each other.
+
+// Parameters within the ranges given by the specification, with small gaps so
+// that short tracks already exercise every LIC.
+inline PARAMETERS_T randomParameters(std::mt19937 &rng) {
+  std::uniform_int_distribution<int> gap(1, 3);
+  std::uniform_real_distribution<double> length(0, 8);
+
+  PARAMETERS_T parameters;
+  parameters.LENGTH1 = length(rng);
+  parameters.RADIUS1 = length(rng);
+  parameters.EPSILON = std::uniform_real_distribution<double>(0, PI)(rng);
+  parameters.AREA1 = length(rng);
+  parameters.Q_PTS = std::uniform_int_distribution<int>(2, 5)(rng);
+  parameters.QUADS = std::uniform_int_distribution<int>(1, 3)(rng);
+  parameters.DIST = length(rng);
+  parameters.N_PTS = std::uniform_int_distribution<int>(3, 5)(rng);
+  parameters.K_PTS = gap(rng);
+  parameters.A_PTS = gap(rng);
+  parameters.B_PTS = gap(rng);
+  parameters.C_PTS = gap(rng);
+  parameters.D_PTS = gap(rng);
+  parameters.E_PTS = gap(rng);
+  parameters.F_PTS = gap(rng);
+  parameters.G_PTS = gap(rng);
+  parameters.LENGTH2 = length(rng);
+  parameters.RADIUS2 = length(rng);
+  parameters.AREA2 = length(rng);
+  return parameters;
+}
+
+// A sparse LCM, so that launch decisions are not always NO.
+inline LCM_T randomLcm(std::mt19937 &rng) {
+  std::uniform_int_distribution<int> connector(0, 5);
+  LCM_T lcm;
+  for (int y = 0; y < 15; ++y) {
+    for (int x = y; x < 15; ++x) {
+      int c = connector(rng);
+      lcm[y][x] = lcm[x][y] = c == 0 ? ANDD : (c == 1 ? ORR : NOTUSED);
+    }
+  }
+  return lcm;
+}
+
+inline std::array<bool, 15> randomPuv(std::mt19937 &rng) {
+  std::array<bool, 15> puv;
+  for (int i = 0; i < 15; ++i) {
+    puv[i] = std::uniform_int_distribution<int>(0, 2)(rng) == 0;
+  }
+  return puv;
+}
+
+inline CONFIG_T randomConfig(std::mt19937 &rng) {
+  CONFIG_T config;
+  config.PARAMETERS = randomParameters(rng);
+  config.LCM = randomLcm(rng);
+  config.PUV = randomPuv(rng);
+  return config;
+}
+
+// Points on a small integer grid, so that coincident and collinear points
+// are common.
+inline std::vector<COORDINATE> randomPoints(std::mt19937 &rng, int NUMPOINTS) {
+  std::uniform_int_distribution<int> coordinate(-4, 4);
+  std::vector<COORDINATE> points(NUMPOINTS);
+  for (COORDINATE &point : points) {
+    point.x = coordinate(rng);
+    point.y = coordinate(rng);
+  }
+  return points;
+}
+
+// Writes points and configuration in the text input format.
+inline std::string textInput(const std::vector<COORDINATE> &points,
+                             const CONFIG_T &config) {
+  std::ostringstream text;
+  text.precision(17);
+  const PARAMETERS_T &p = config.PARAMETERS;
+  text << points.size() << "\n";
+  for (const COORDINATE &point : points) {
+    text << point.x << " " << point.y << "\n";
+  }
+  text << p.LENGTH1 << " " << p.RADIUS1 << " " << p.EPSILON << " " << p.AREA1
+       << " " << p.Q_PTS << " " << p.QUADS << " " << p.DIST << " " << p.N_PTS
+       << " " << p.K_PTS << " " << p.A_PTS << " " << p.B_PTS << " " << p.C_PTS
+       << " " << p.D_PTS << " " << p.E_PTS << " " << p.F_PTS << " " << p.G_PTS
+       << " " << p.LENGTH2 << " " << p.RADIUS2 << " " << p.AREA2 << "\n";
+  for (int i = 0; i < 15; ++i) {
+    for (int j = 0; j < 15; ++j) {
+      text << (config.LCM[i][j] == ANDD  ? "ANDD "
+               : config.LCM[i][j] == ORR ? "ORR "
+                                         : "NOTUSED ");
+    }
+    text << "\n";
+  }
+  for (int i = 0; i < 15; ++i) {
+    text << (config.PUV[i] ? "T " : "F ");
+  }
+  return text.str();
+}
+
+#endif